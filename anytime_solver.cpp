@@ -0,0 +1,177 @@
+#include "delivery_uav.h"
+#include "cost_model.h"
+#include "path_utils.h"
+#include "solve_workspace.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Predecessors per row of the heuristic (bounded-skip) DP
+constexpr int kHeuristicWindow = 16;
+// Candidates evaluated between two clock reads of the exact pass
+constexpr long long kCheckInterval = 16384;
+
+/**
+ * @brief Row i of the bounded-skip DP over the previous kHeuristicWindow
+ *        points of `dp` (any mix of exact and heuristic values)
+ */
+RelaxResult relaxHeuristicRow(const WaypointColumns& cols, const double* dp, int i, const EuclideanCost& cost)
+{
+  RelaxResult best{ std::numeric_limits<double>::max(), -1 };
+  const double penalties_before_i = cols.prefix[i - 1];
+  for (int j = std::max(0, i - kHeuristicWindow); j < i; ++j) {
+    const double time_candidate = dp[j] + cost.travelTime(cols.x[j], cols.y[j], cols.x[i], cols.y[i], j, i, dp[j]) +
+      (penalties_before_i - cols.prefix[j]);
+    if (time_candidate < best.min_time) {
+      best.min_time = time_candidate;
+      best.best_prev = j;
+    }
+  }
+  return best;
+}
+
+} // namespace
+
+
+/**
+ * @brief Deadline-bounded solve that returns the best route found in time
+ *
+ * 1. Heuristic: the bounded-skip DP with kHeuristicWindow predecessors per
+ *    row, O(N) and always a valid route (first upper bound).
+ * 2. Refinement: the exact pruned DP of solvePruned(), row by row, until the
+ *    deadline minus the time needed for step 3 or the last row.
+ * 3. Completion: if the exact pass stopped at row r, rows r+1..N+1 are
+ *    redone with the heuristic DP on top of the exact values. Every row is
+ *    then at most its heuristic value, so the route only improves on step 1
+ *    and converges to the optimum as r grows.
+ * Lower bound: every route leaves the exact rows at some point j <= r, flies
+ * at least |j, terminal| (triangle inequality), pays every skipped penalty
+ * up to r and, for every later waypoint, at least min(wait, penalty):
+ *   min_j (dp[j] - prefix[j] + |j, T| / speed) + prefix[r]
+ *     + sum_{r < k < T} min(wait, penalty_k) + wait.
+ *
+ * Only the Euclidean cost is supported by the bound; with another cost model
+ * the route is solved exactly by solveRoute() and the budget is ignored.
+ *
+ * @param cols      Columns of [start, wp1, wp2..., terminal] with penalty prefix sums
+ * @param budget_ms Time budget in milliseconds (<= 0: the heuristic route only)
+ * @param result    Receives the route, the optimality flag and the gap
+ * @param stats     Optional sink for solver counters
+ */
+void DeliveryUAV::solveWithinDeadline(
+  const WaypointColumns& cols,
+  double budget_ms,
+  AnytimeResult& result,
+  SolveStats* stats) const
+{
+  SolveStats route_stats;
+  if (cost_model_ && cost_model_->kind != CostModelKind::Euclidean) {
+    result.total_time = solveRoute(cols, result.path, &route_stats);
+    result.optimal = true;
+    result.lower_bound = result.total_time;
+    result.gap = 0.0;
+    result.exact_rows = cols.count;
+    if (stats) *stats = route_stats;
+    return;
+  }
+
+  const auto start = Clock::now();
+  const auto deadline = start + std::chrono::duration_cast<Clock::duration>(
+    std::chrono::duration<double, std::milli>(std::max(0.0, budget_ms)));
+  const int total_points = cols.count - 1;
+  const double* prefix = cols.prefix;
+  const EuclideanCost cost(uav_speed_);
+  SolveWorkspace& ws = workspace();
+
+  // 1. Heuristic route
+  std::vector<double>& upper = ws.upper;
+  std::vector<int>& upper_prev = ws.upper_prev;
+  upper.assign(total_points + 1, 0.0);
+  upper_prev.assign(total_points + 1, -1);
+  for (int i = 1; i <= total_points; ++i) {
+    const RelaxResult best = relaxHeuristicRow(cols, upper.data(), i, cost);
+    upper[i] = best.min_time + wait_time_;
+    upper_prev[i] = best.best_prev;
+    route_stats.candidates_evaluated += std::min(i, kHeuristicWindow);
+  }
+  const Clock::duration heuristic_time = Clock::now() - start;
+
+  // 2. Exact rows (solvePruned()) while the completion still fits the budget
+  AlignedVector<double>& dp = ws.dp;
+  dp.assign(total_points + 1, std::numeric_limits<double>::infinity());
+  dp[0] = 0.0;
+  std::vector<double>& floor = ws.floor;
+  floor.assign(total_points + 1, 0.0);
+  floor[0] = dp[0] - prefix[0];
+  std::vector<int>& prev_waypoint = ws.prev_waypoint;
+  prev_waypoint.assign(total_points + 1, -1);
+
+  int exact = 0;  // rows 0..exact hold exact values
+  long long next_check = route_stats.candidates_evaluated;
+  while (exact < total_points) {
+    if (route_stats.candidates_evaluated >= next_check) {
+      const double remaining = (double)(total_points - exact) / total_points;
+      if (Clock::now() + std::chrono::duration_cast<Clock::duration>(heuristic_time * remaining) > deadline) break;
+      next_check = route_stats.candidates_evaluated + kCheckInterval;
+    }
+    const int i = exact + 1;
+    double min_time = std::numeric_limits<double>::max();
+    int bestPrev = -1;
+    const double penalties_before_i = prefix[i - 1];
+    for (int j = i - 1; j >= 0; --j) {
+      if (floor[j] + penalties_before_i - min_time > 1e-12 * std::fabs(min_time)) break;
+      const double time_candidate = dp[j] + cost.travelTime(cols.x[j], cols.y[j], cols.x[i], cols.y[i], j, i, dp[j]) +
+        (penalties_before_i - prefix[j]);
+      ++route_stats.candidates_evaluated;
+      if (time_candidate <= min_time) {
+        min_time = time_candidate;
+        bestPrev = j;
+      }
+    }
+    dp[i] = min_time + wait_time_;
+    prev_waypoint[i] = bestPrev;
+    floor[i] = std::min(floor[i - 1], dp[i] - prefix[i]);
+    exact = i;
+  }
+
+  result.exact_rows = exact + 1;
+  result.optimal = exact == total_points;
+  if (result.optimal) {
+    reconstructPath(prev_waypoint, total_points, result.path);
+    result.total_time = dp[total_points];
+    result.lower_bound = result.total_time;
+    result.gap = 0.0;
+  }
+  else {
+    // 3. Heuristic completion on top of the exact rows
+    std::copy(dp.begin(), dp.begin() + exact + 1, upper.begin());
+    std::copy(prev_waypoint.begin(), prev_waypoint.begin() + exact + 1, upper_prev.begin());
+    for (int i = exact + 1; i <= total_points; ++i) {
+      const RelaxResult best = relaxHeuristicRow(cols, upper.data(), i, cost);
+      upper[i] = best.min_time + wait_time_;
+      upper_prev[i] = best.best_prev;
+      route_stats.candidates_evaluated += std::min(i, kHeuristicWindow);
+    }
+    reconstructPath(upper_prev, total_points, result.path);
+    result.total_time = upper[total_points];
+
+    double leave = std::numeric_limits<double>::infinity();
+    for (int j = 0; j <= exact; ++j) {
+      leave = std::min(leave, dp[j] - prefix[j] +
+        cost.travelTime(cols.x[j], cols.y[j], cols.x[total_points], cols.y[total_points], j, total_points, dp[j]));
+    }
+    double rest = wait_time_;
+    for (int k = exact + 1; k < total_points; ++k) rest += std::min(wait_time_, prefix[k] - prefix[k - 1]);
+    result.lower_bound = std::min(result.total_time, leave + prefix[exact] + rest);
+    result.gap = result.total_time > 0.0 ? (result.total_time - result.lower_bound) / result.total_time : 0.0;
+  }
+
+  route_stats.proven_optimal = result.optimal;
+  route_stats.optimality_gap = result.gap;
+  if (stats) *stats = route_stats;
+}
@@ -0,0 +1,217 @@
+#include "batch_runner.h"
+#include "delivery_uav.h"
+#include "result_cache.h"
+#include "route_file.h"
+#include "solve_verify.h"
+#include "work_stealing_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <system_error>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+/**
+ * @brief Returns true for files that look like waypoint inputs: a .txt
+ *        extension and not a solution file (suffix _sol.txt).
+ */
+bool isCaseFile(const fs::path& path)
+{
+  const std::string name = path.filename().string();
+  const std::string sol_suffix = "_sol.txt";
+  if (path.extension() != ".txt") return false;
+  return name.size() < sol_suffix.size() ||
+    name.compare(name.size() - sol_suffix.size(), sol_suffix.size(), sol_suffix) != 0;
+}
+
+std::uintmax_t fileSizeOrZero(const std::string& path)
+{
+  std::error_code ec;
+  const std::uintmax_t size = fs::file_size(path, ec);
+  return ec ? 0 : size;
+}
+
+} // namespace
+
+
+/**
+ * @brief Builds the list of cases to solve from a directory or a manifest file
+ *
+ * - Directory: every `*.txt` file except solution files (`*_sol.txt`) is a
+ *   case; `<name>.txt` is solved into `<output_dir>/<name>_sol.txt`. The
+ *   output directory is required, so reference solutions stored next to
+ *   the inputs are never overwritten by accident.
+ * - Manifest: each non-empty line not starting with '#' holds
+ *   `<input_path> <output_path>`. Relative paths are taken as is.
+ *
+ * @param source     Directory of cases or path of a manifest file
+ * @param output_dir Output directory, required for directory sources
+ * @param jobs       Receives the cases, in directory or manifest order
+ * @return bool      False (with a message on cerr) if the source cannot be read
+ */
+bool collectBatchJobs(const std::string& source, const std::string& output_dir, std::vector<BatchJob>& jobs)
+{
+  jobs.clear();
+  std::error_code ec;
+
+  if (fs::is_directory(source, ec)) {
+    if (output_dir.empty()) {
+      std::cerr << "Batch directory " << source << " requires --out-dir for the solutions\n";
+      return false;
+    }
+    const fs::path out_dir(output_dir);
+    fs::create_directories(out_dir, ec);
+    if (ec) {
+      std::cerr << "Error creating output directory: " << out_dir.string() << '\n';
+      return false;
+    }
+    for (const auto& entry : fs::directory_iterator(source, ec)) {
+      if (!entry.is_regular_file() || !isCaseFile(entry.path())) continue;
+      const std::string stem = entry.path().stem().string();
+      jobs.push_back({ entry.path().string(), (out_dir / (stem + "_sol.txt")).string() });
+    }
+    std::sort(jobs.begin(), jobs.end(),
+      [](const BatchJob& a, const BatchJob& b) { return a.input_path < b.input_path; });
+    return true;
+  }
+
+  std::ifstream manifest(source);
+  if (!manifest.is_open()) {
+    std::cerr << "Error opening batch source: " << source << '\n';
+    return false;
+  }
+  std::string line;
+  int line_number = 0;
+  while (std::getline(manifest, line)) {
+    ++line_number;
+    std::istringstream fields(line);
+    BatchJob job;
+    if (!(fields >> job.input_path) || job.input_path[0] == '#') continue;
+    if (!(fields >> job.output_path)) {
+      std::cerr << "Invalid manifest line " << line_number << " in " << source
+        << ": expected <input_path> <output_path>\n";
+      return false;
+    }
+    jobs.push_back(job);
+  }
+  return true;
+}
+
+
+/**
+ * @brief Solves every case of a batch concurrently from a single process
+ *
+ * Each case is one task on a work-stealing pool. Cases are submitted largest
+ * file first, so the long solves start early and small ones fill the gaps.
+ * The pool is also installed as the UAV's executor: with
+ * SolverMode::Parallel, the long rows of a large case are split further
+ * across workers that run out of cases. Every case writes its own output
+ * file as soon as it finishes, and a progress line is printed to stdout.
+ * With a result cache on the UAV, its hit rate and mean lookup time are
+ * printed after the summary. With verify_every > 0, every verify_every-th
+ * case of the job list is solved again by verifySolve() after its output is
+ * written; a failed check counts the case as failed.
+ *
+ * @param uav              Configured UAV; shared by all tasks (solveCase is thread-safe)
+ * @param jobs             Cases to solve
+ * @param threads          Number of worker threads (0 = all hardware threads)
+ * @param verify_every     Verify cases 0, n, 2n... of the job list (0 = none)
+ * @param verify_tolerance Relative tolerance of the verified times
+ * @return int             EXIT_SUCCESS if every case was solved (and passed
+ *                         verification), EXIT_FAILURE otherwise
+ */
+int runBatch(DeliveryUAV& uav, const std::vector<BatchJob>& jobs, int threads, int verify_every,
+  double verify_tolerance)
+{
+  const auto batch_start = std::chrono::steady_clock::now();
+  if (threads == 0) threads = (int)std::max(1u, std::thread::hardware_concurrency());
+
+  std::vector<size_t> order(jobs.size());
+  std::vector<std::uintmax_t> sizes(jobs.size());
+  for (size_t k = 0; k < jobs.size(); ++k) {
+    order[k] = k;
+    sizes[k] = fileSizeOrZero(jobs[k].input_path);
+  }
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return sizes[a] > sizes[b]; });
+
+  std::atomic<int> solved{ 0 };
+  std::atomic<int> failed{ 0 };
+  std::atomic<int> verified{ 0 };
+  std::atomic<int> verify_failed{ 0 };
+  std::mutex report_mutex;
+  {
+    WorkStealingPool pool(threads);
+    uav.setExecutor(&pool);
+
+    for (const size_t k : order) {
+      pool.submit([&, k] {
+        const auto case_start = std::chrono::steady_clock::now();
+        SolveStats stats;
+        int status = uav.solveCase(jobs[k].input_path, jobs[k].output_path, &stats);
+        const auto case_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::steady_clock::now() - case_start).count();
+
+        bool verify = false;
+        VerifyReport report;
+        std::string verify_error;
+        if (status == EXIT_SUCCESS && verify_every > 0 && k % verify_every == 0) {
+          RouteFile route;
+          std::string error;
+          if (route.open(jobs[k].input_path, error)) {
+            report = verifySolve(uav, route.columns(), verify_tolerance);
+            verify = true;
+            verified.fetch_add(1);
+            if (!report.passed()) {
+              verify_failed.fetch_add(1);
+              status = EXIT_FAILURE;
+            }
+          }
+          else {
+            verify_error = error;
+            status = EXIT_FAILURE;
+          }
+        }
+
+        (status == EXIT_SUCCESS ? solved : failed).fetch_add(1);
+        std::lock_guard<std::mutex> lock(report_mutex);
+        std::cout << '[' << (solved.load() + failed.load()) << '/' << jobs.size() << "] "
+          << (status == EXIT_SUCCESS ? "solved " : "FAILED ") << jobs[k].input_path
+          << " -> " << jobs[k].output_path << " (" << case_ms << " ms, ";
+        if (stats.cache_hit) std::cout << "cached)\n" << std::flush;
+        else std::cout << stats.candidates_evaluated << " candidates)\n" << std::flush;
+        if (verify) {
+          std::cout << "  ";
+          printVerifyReport(std::cout, report);
+        }
+        if (!verify_error.empty()) std::cerr << "Verify: " << verify_error << '\n';
+      });
+    }
+    pool.waitIdle();
+    uav.setExecutor(nullptr);
+  }
+
+  const auto batch_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+    std::chrono::steady_clock::now() - batch_start).count();
+  std::cout << "Batch: " << solved.load() << '/' << jobs.size() << " cases solved in "
+    << batch_ms << " ms using " << threads << " threads\n";
+  if (const ResultCache* cache = uav.resultCache()) {
+    const ResultCacheStats cache_stats = cache->stats();
+    std::cout << "Cache: " << cache_stats.hits << '/' << cache_stats.lookups << " hits ("
+      << cache_stats.hitRate() * 100.0 << "%), mean lookup " << cache_stats.meanLookupUs() << " us, "
+      << cache_stats.entries << " entries, " << cache_stats.bytes << " bytes\n";
+  }
+  if (verify_every > 0) {
+    std::cout << "Verify: " << verified.load() - verify_failed.load() << '/' << verified.load()
+      << " sampled cases passed\n";
+  }
+
+  return failed.load() == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
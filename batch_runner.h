@@ -0,0 +1,20 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+class DeliveryUAV;
+
+/**
+ * BatchJob: one case of a batch run.
+ * - input_path: Path to the case's input file.
+ * - output_path: Path the case's solution is written to.
+ */
+struct BatchJob {
+  std::string input_path;
+  std::string output_path;
+};
+
+bool collectBatchJobs(const std::string& source, const std::string& output_dir, std::vector<BatchJob>& jobs);
+int runBatch(DeliveryUAV& uav, const std::vector<BatchJob>& jobs, int threads, int verify_every = 0,
+  double verify_tolerance = 1e-9);
@@ -0,0 +1,306 @@
+#include "delivery_uav.h"
+#include "route_generator.h"
+#include "simd_kernels.h"
+#include "solve_workspace.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * BenchConfig: Structure to hold the parameters of a benchmark run.
+ * - sizes: Numbers of waypoints to generate.
+ * - shapes / penalties: Route families to generate (see route_generator.h).
+ * - solvers: Solver variants to time.
+ * - warmup / repetitions: Untimed and timed runs per measurement.
+ * - max_quadratic: Largest route given to the exhaustive O(N^2) solvers.
+ * - max_pruned: Largest route given to the pruned solver (still quadratic
+ *   when skips are cheap, e.g. with light penalties).
+ * - threads: Threads for the parallel solver (0 = all cores).
+ * - max_skip: Skip limit of the window solver (O(N * K), never skipped by size).
+ * - tile_size: Cache tile of the simd solver (0 = untiled).
+ * - seed: Base seed of the route generator.
+ * - csv_path / json_path: Optional result files.
+ * - emit_dir: Optional directory receiving every generated route as a text
+ *   input file, so it can be replayed through the main program.
+ */
+struct BenchConfig {
+  std::vector<int> sizes = { 10, 100, 1000, 10000, 100000, 1000000 };
+  std::vector<RouteShape> shapes = { RouteShape::Uniform, RouteShape::Clustered, RouteShape::Corridor };
+  std::vector<PenaltyProfile> penalties = { PenaltyProfile::Light, PenaltyProfile::Heavy };
+  std::vector<SolverMode> solvers = { SolverMode::Baseline, SolverMode::Pruned, SolverMode::Simd, SolverMode::Parallel };
+  int warmup = 1;
+  int repetitions = 5;
+  int max_quadratic = 20000;
+  int max_pruned = 100000;
+  int threads = 0;
+  int max_skip = 64;
+  int tile_size = 0;
+  std::uint64_t seed = 1;
+  std::string csv_path;
+  std::string json_path;
+  std::string emit_dir;
+};
+
+/**
+ * BenchResult: One measured (route, solver) combination.
+ */
+struct BenchResult {
+  RouteSpec spec;
+  SolverMode solver;
+  int threads;
+  int repetitions;
+  double median_ms;
+  double p99_ms;
+  double min_ms;
+  double ns_per_relaxation;
+  long long candidates;
+  double total_time;
+  long scratch_kb;
+};
+
+const char* solver_name(SolverMode mode) {
+  switch (mode) {
+  case SolverMode::Pruned:   return "pruned";
+  case SolverMode::Simd:     return "simd";
+  case SolverMode::Parallel: return "parallel";
+  case SolverMode::Window:   return "window";
+  case SolverMode::Separable: return "separable";
+  case SolverMode::Spatial:  return "spatial";
+  case SolverMode::Gpu:      return "gpu";
+  case SolverMode::Baseline: break;
+  }
+  return "baseline";
+}
+
+SolverMode parse_solver(const std::string& name) {
+  for (SolverMode mode : { SolverMode::Baseline, SolverMode::Pruned, SolverMode::Simd, SolverMode::Parallel,
+    SolverMode::Window, SolverMode::Separable, SolverMode::Spatial,
+    SolverMode::Gpu }) {
+    if (name == solver_name(mode)) return mode;
+  }
+  throw std::runtime_error("Unknown solver '" + name + "'");
+}
+
+std::vector<std::string> split_list(const std::string& list) {
+  std::vector<std::string> items;
+  std::stringstream stream(list);
+  std::string item;
+  while (std::getline(stream, item, ',')) {
+    if (!item.empty()) items.push_back(item);
+  }
+  return items;
+}
+
+/**
+ * parse_arguments: Parses the benchmark options; every option is optional.
+ * - Throws runtime_error for unknown options or values.
+ */
+BenchConfig parse_arguments(int argc, char* argv[]) {
+  const std::string usage = "Usage: " + std::string(argv[0]) +
+    " [--sizes n,...] [--shapes uniform,clustered,corridor] [--penalties light,heavy]"
+    " [--solvers baseline,pruned,simd,parallel,window,separable,spatial,gpu] [--warmup n] [--reps n] [--max-quadratic n]"
+    " [--max-pruned n] [--max-skip k] [--tile-size t] [--threads n] [--seed s] [--csv path] [--json path] [--emit dir]";
+
+  BenchConfig cfg;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (i + 1 >= argc) throw std::runtime_error(usage);
+    const std::string value = argv[++i];
+
+    if (arg == "--sizes") {
+      cfg.sizes.clear();
+      for (const auto& item : split_list(value)) cfg.sizes.push_back(std::stoi(item));
+    }
+    else if (arg == "--shapes") {
+      cfg.shapes.clear();
+      for (const auto& item : split_list(value)) {
+        RouteShape shape;
+        if (!parseRouteShape(item, shape)) throw std::runtime_error("Unknown shape '" + item + "'");
+        cfg.shapes.push_back(shape);
+      }
+    }
+    else if (arg == "--penalties") {
+      cfg.penalties.clear();
+      for (const auto& item : split_list(value)) {
+        PenaltyProfile profile;
+        if (!parsePenaltyProfile(item, profile)) throw std::runtime_error("Unknown penalty profile '" + item + "'");
+        cfg.penalties.push_back(profile);
+      }
+    }
+    else if (arg == "--solvers") {
+      cfg.solvers.clear();
+      for (const auto& item : split_list(value)) cfg.solvers.push_back(parse_solver(item));
+    }
+    else if (arg == "--warmup") cfg.warmup = std::stoi(value);
+    else if (arg == "--reps") cfg.repetitions = std::max(1, std::stoi(value));
+    else if (arg == "--max-quadratic") cfg.max_quadratic = std::stoi(value);
+    else if (arg == "--max-pruned") cfg.max_pruned = std::stoi(value);
+    else if (arg == "--threads") cfg.threads = std::stoi(value);
+    else if (arg == "--max-skip") cfg.max_skip = std::stoi(value);
+    else if (arg == "--tile-size") cfg.tile_size = std::stoi(value);
+    else if (arg == "--seed") cfg.seed = std::stoull(value);
+    else if (arg == "--csv") cfg.csv_path = value;
+    else if (arg == "--json") cfg.json_path = value;
+    else if (arg == "--emit") cfg.emit_dir = value;
+    else throw std::runtime_error(usage);
+  }
+  return cfg;
+}
+
+/**
+ * measure: Times one solver on one generated route.
+ * Runs `warmup` untimed solves, then `repetitions` timed solves of
+ * DeliveryUAV::solveRoute (no file I/O) and summarizes them. The solves use
+ * a fresh workspace, whose scratch buffers afterwards give the memory
+ * footprint of this solver on this route.
+ */
+BenchResult measure(DeliveryUAV& uav, const BenchConfig& cfg, const RouteSpec& spec,
+  const WaypointColumns& cols, SolverMode solver) {
+  uav.setSolverMode(solver);
+  SolveWorkspace workspace;
+  uav.setWorkspace(&workspace);
+  std::vector<int> path;
+  SolveStats stats;
+  double total_time = 0.0;
+
+  for (int w = 0; w < cfg.warmup; ++w) total_time = uav.solveRoute(cols, path, &stats);
+
+  std::vector<double> samples_ms;
+  for (int r = 0; r < cfg.repetitions; ++r) {
+    const auto start = std::chrono::steady_clock::now();
+    total_time = uav.solveRoute(cols, path, &stats);
+    const auto end = std::chrono::steady_clock::now();
+    samples_ms.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+  }
+  std::sort(samples_ms.begin(), samples_ms.end());
+
+  const size_t count = samples_ms.size();
+  const double median = (count % 2) ? samples_ms[count / 2]
+    : 0.5 * (samples_ms[count / 2 - 1] + samples_ms[count / 2]);
+  const size_t p99_rank = (size_t)std::ceil(0.99 * count);  // nearest-rank percentile
+  const double p99 = samples_ms[std::min(count, std::max<size_t>(1, p99_rank)) - 1];
+
+  BenchResult result;
+  result.spec = spec;
+  result.solver = solver;
+  result.threads = (solver == SolverMode::Parallel) ? uav.threads() : 1;
+  result.repetitions = cfg.repetitions;
+  result.median_ms = median;
+  result.p99_ms = p99;
+  result.min_ms = samples_ms.front();
+  result.candidates = stats.candidates_evaluated;
+  result.ns_per_relaxation = stats.candidates_evaluated > 0 ? median * 1e6 / stats.candidates_evaluated : 0.0;
+  result.total_time = total_time;
+  result.scratch_kb = (long)((workspace.scratchBytes() + 1023) / 1024);
+  uav.setWorkspace(nullptr);
+  return result;
+}
+
+void write_csv(const std::string& path, const std::vector<BenchResult>& results) {
+  std::ofstream out(path);
+  out << "shape,penalties,waypoints,seed,solver,threads,repetitions,median_ms,p99_ms,min_ms,"
+    "ns_per_relaxation,candidates,total_time,scratch_kb\n";
+  out << std::setprecision(9);
+  for (const auto& r : results) {
+    out << routeShapeName(r.spec.shape) << ',' << penaltyProfileName(r.spec.penalties) << ','
+      << r.spec.waypoints << ',' << r.spec.seed << ',' << solver_name(r.solver) << ','
+      << r.threads << ',' << r.repetitions << ',' << r.median_ms << ',' << r.p99_ms << ','
+      << r.min_ms << ',' << r.ns_per_relaxation << ',' << r.candidates << ','
+      << r.total_time << ',' << r.scratch_kb << '\n';
+  }
+}
+
+void write_json(const std::string& path, const std::vector<BenchResult>& results) {
+  std::ofstream out(path);
+  out << std::setprecision(9) << "[\n";
+  for (size_t k = 0; k < results.size(); ++k) {
+    const auto& r = results[k];
+    out << "  {\"shape\": \"" << routeShapeName(r.spec.shape) << "\", \"penalties\": \""
+      << penaltyProfileName(r.spec.penalties) << "\", \"waypoints\": " << r.spec.waypoints
+      << ", \"seed\": " << r.spec.seed << ", \"solver\": \"" << solver_name(r.solver)
+      << "\", \"threads\": " << r.threads << ", \"repetitions\": " << r.repetitions
+      << ", \"median_ms\": " << r.median_ms << ", \"p99_ms\": " << r.p99_ms
+      << ", \"min_ms\": " << r.min_ms << ", \"ns_per_relaxation\": " << r.ns_per_relaxation
+      << ", \"candidates\": " << r.candidates << ", \"total_time\": " << r.total_time
+      << ", \"scratch_kb\": " << r.scratch_kb << '}' << (k + 1 < results.size() ? "," : "") << '\n';
+  }
+  out << "]\n";
+}
+
+/**
+ * main: Benchmark suite entry point.
+ * Workflow:
+ * 1. Generates every (shape, penalty profile, size) route from the seed.
+ * 2. Times each requested solver on it; exhaustive solvers (baseline, simd,
+ *    parallel) are skipped above --max-quadratic waypoints, the pruned
+ *    solver above --max-pruned.
+ * 3. Prints a summary table and writes optional CSV / JSON files.
+ */
+int main(int argc, char* argv[]) {
+  BenchConfig cfg;
+  try {
+    cfg = parse_arguments(argc, argv);
+  }
+  catch (const std::exception& e) {
+    std::cerr << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+
+  DeliveryUAV uav(2.0, 10.0, cfg.threads);
+  uav.setMaxSkip(cfg.max_skip);
+  uav.setTileSize(cfg.tile_size);
+  std::cout << "SIMD level: " << simdLevelName(uav.simdLevel()) << ", threads: " << uav.threads() << '\n';
+  std::cout << std::left << std::setw(10) << "shape" << std::setw(7) << "pen" << std::setw(9) << "N"
+    << std::setw(10) << "solver" << std::right << std::setw(12) << "median ms" << std::setw(12) << "p99 ms"
+    << std::setw(12) << "ns/relax" << std::setw(12) << "scratch KiB" << '\n';
+
+  std::vector<BenchResult> results;
+  for (const RouteShape shape : cfg.shapes) {
+    for (const PenaltyProfile profile : cfg.penalties) {
+      for (const int size : cfg.sizes) {
+        RouteSpec spec;
+        spec.shape = shape;
+        spec.penalties = profile;
+        spec.waypoints = size;
+        spec.seed = cfg.seed;
+        const WaypointSoA route = generateRoute(spec);
+        if (!cfg.emit_dir.empty()) {
+          const std::string emit_path = cfg.emit_dir + "/" + routeShapeName(shape) + "_"
+            + penaltyProfileName(profile) + "_" + std::to_string(size) + ".txt";
+          if (!writeWaypointText(route.columns(), emit_path)) {
+            std::cerr << "Error writing route file: " << emit_path << '\n';
+            return EXIT_FAILURE;
+          }
+        }
+
+        for (const SolverMode solver : cfg.solvers) {
+          std::cout << std::left << std::setw(10) << routeShapeName(shape) << std::setw(7)
+            << penaltyProfileName(profile) << std::setw(9) << size << std::setw(10) << solver_name(solver);
+          const int limit = (solver == SolverMode::Window) ? size
+            : (solver == SolverMode::Pruned || solver == SolverMode::Separable || solver == SolverMode::Spatial)
+              ? cfg.max_pruned : cfg.max_quadratic;
+          if (size > limit) {
+            std::cout << std::right << std::setw(12) << "skipped" << '\n';
+            continue;
+          }
+          const BenchResult r = measure(uav, cfg, spec, route.columns(), solver);
+          results.push_back(r);
+          std::cout << std::right << std::fixed << std::setprecision(3) << std::setw(12) << r.median_ms
+            << std::setw(12) << r.p99_ms << std::setw(12) << r.ns_per_relaxation
+            << std::setw(12) << r.scratch_kb << '\n' << std::flush;
+        }
+      }
+    }
+  }
+
+  if (!cfg.csv_path.empty()) write_csv(cfg.csv_path, results);
+  if (!cfg.json_path.empty()) write_json(cfg.json_path, results);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,197 @@
+#include "binary_route.h"
+#include "mapped_file.h"
+#include "waypoint_loader.h"
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kColumnAlignment = 64;
+
+std::size_t alignUp(std::size_t offset)
+{
+  return (offset + kColumnAlignment - 1) & ~(kColumnAlignment - 1);
+}
+
+/**
+ * ColumnLayout: byte offsets of the four columns for a given point count.
+ */
+struct ColumnLayout {
+  std::size_t x, y, penalty, prefix, end;
+
+  ColumnLayout(std::uint64_t count, bool float32) {
+    const std::size_t value_size = float32 ? sizeof(float) : sizeof(double);
+    x = alignUp(sizeof(BinaryRouteHeader));
+    y = alignUp(x + count * value_size);
+    penalty = alignUp(y + count * value_size);
+    prefix = alignUp(penalty + count * value_size);
+    end = prefix + count * sizeof(double);
+  }
+};
+
+void widen(const char* src, std::size_t count, AlignedVector<double>& dst)
+{
+  dst.resize(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    float value;
+    std::memcpy(&value, src + i * sizeof(float), sizeof(float));
+    dst[i] = value;
+  }
+}
+
+template <typename T>
+void writeColumn(std::ofstream& out, const double* values, std::size_t count, std::size_t offset)
+{
+  const std::size_t pos = (std::size_t)out.tellp();
+  static const char zeros[kColumnAlignment] = {};
+  out.write(zeros, (std::streamsize)(offset - pos));  // padding up to the column start
+
+  std::vector<T> column(values, values + count);
+  out.write(reinterpret_cast<const char*>(column.data()), (std::streamsize)(count * sizeof(T)));
+}
+
+} // namespace
+
+
+/**
+ * @brief Returns true if the buffer starts with the binary route magic
+ */
+bool isBinaryRoute(const char* data, std::size_t size)
+{
+  return size >= sizeof(kBinaryRouteMagic) && std::memcmp(data, kBinaryRouteMagic, sizeof(kBinaryRouteMagic)) == 0;
+}
+
+/**
+ * @brief Validates a binary route and exposes its columns
+ *
+ * @param data  First byte of the file contents (aligned to at least 8 bytes)
+ * @param size  Size of the file contents in bytes
+ * @param error Receives a message on failure
+ * @return bool True if the header and column sizes are consistent
+ */
+bool BinaryRouteView::open(const char* data, std::size_t size, std::string& error)
+{
+  if (size < sizeof(BinaryRouteHeader) || !isBinaryRoute(data, size)) {
+    error = "not a binary route file";
+    return false;
+  }
+  BinaryRouteHeader header;
+  std::memcpy(&header, data, sizeof(header));
+  if (header.version != kBinaryRouteVersion) {
+    error = "unsupported binary route version or byte order (" + std::to_string(header.version) + ")";
+    return false;
+  }
+  if (header.waypoint_count > (1ULL << 30)) {
+    error = "Number of waypoints (" + std::to_string(header.waypoint_count) + ") is too large";
+    return false;
+  }
+
+  const std::uint64_t count = header.waypoint_count + 2;
+  const bool float32 = (header.flags & kBinaryRouteFloat32) != 0;
+  const ColumnLayout layout(count, float32);
+  if (size < layout.end) {
+    error = "truncated binary route: expected " + std::to_string(layout.end) +
+      " bytes, found " + std::to_string(size);
+    return false;
+  }
+
+  columns_.count = (int)count;
+  columns_.prefix = reinterpret_cast<const double*>(data + layout.prefix);
+  if (float32) {
+    widen(data + layout.x, count, widened_.x);
+    widen(data + layout.y, count, widened_.y);
+    widen(data + layout.penalty, count, widened_.penalty);
+    columns_.x = widened_.x.data();
+    columns_.y = widened_.y.data();
+    columns_.penalty = widened_.penalty.data();
+  }
+  else {
+    columns_.x = reinterpret_cast<const double*>(data + layout.x);
+    columns_.y = reinterpret_cast<const double*>(data + layout.y);
+    columns_.penalty = reinterpret_cast<const double*>(data + layout.penalty);
+  }
+  return true;
+}
+
+/**
+ * @brief Writes waypoint columns as a binary route file
+ *
+ * @param cols    [start, wp1..wpN, terminal] with penalty prefix sums
+ * @param path    Output file
+ * @param float32 Store x, y and penalty as float32 (prefix sums stay float64)
+ * @param error   Receives a message on failure
+ * @return bool True on success
+ */
+bool writeBinaryRoute(const WaypointColumns& cols, const std::string& path, bool float32, std::string& error)
+{
+  std::ofstream out(path, std::ios::binary);
+  if (!out.is_open()) {
+    error = "cannot open file";
+    return false;
+  }
+
+  const std::uint64_t count = (std::uint64_t)cols.count;
+  BinaryRouteHeader header = {};
+  std::memcpy(header.magic, kBinaryRouteMagic, sizeof(header.magic));
+  header.version = kBinaryRouteVersion;
+  header.flags = float32 ? kBinaryRouteFloat32 : 0u;
+  header.start_x = cols.x[0];
+  header.start_y = cols.y[0];
+  header.term_x = cols.x[count - 1];
+  header.term_y = cols.y[count - 1];
+  header.waypoint_count = count - 2;
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  const ColumnLayout layout(count, float32);
+  if (float32) {
+    writeColumn<float>(out, cols.x, count, layout.x);
+    writeColumn<float>(out, cols.y, count, layout.y);
+    writeColumn<float>(out, cols.penalty, count, layout.penalty);
+  }
+  else {
+    writeColumn<double>(out, cols.x, count, layout.x);
+    writeColumn<double>(out, cols.y, count, layout.y);
+    writeColumn<double>(out, cols.penalty, count, layout.penalty);
+  }
+  writeColumn<double>(out, cols.prefix, count, layout.prefix);
+
+  if (!out.good()) {
+    error = "write failed";
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Converts a text waypoint file into the binary route format
+ *
+ * The prefix sums are computed once here, so every later solve of the route
+ * (e.g. with a different uav_speed / wait_time) skips parsing entirely.
+ *
+ * @param input_file_name  Text input (see parseWaypointText())
+ * @param output_file_name Binary output
+ * @param float32          Store x, y and penalty as float32
+ * @return int Status code: 0 for success, 1 for errors
+ */
+int convertTextToBinary(const std::string& input_file_name, const std::string& output_file_name, bool float32)
+{
+  MappedFile input_file;
+  if (!input_file.open(input_file_name)) {
+    std::cerr << "Error opening input file: " << input_file_name << '\n';
+    return EXIT_FAILURE;
+  }
+  WaypointSoA soa;
+  std::string error;
+  if (!parseWaypointText(input_file.data(), input_file.data() + input_file.size(), soa, error)) {
+    std::cerr << "Invalid input format in " << input_file_name << ", " << error << '\n';
+    return EXIT_FAILURE;
+  }
+  if (!writeBinaryRoute(soa.columns(), output_file_name, float32, error)) {
+    std::cerr << "Error writing binary route " << output_file_name << ": " << error << '\n';
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "waypoint_soa.h"
+
+/**
+ * Binary waypoint format ("UAV route", version 1), native little-endian:
+ *
+ *   offset 0   BinaryRouteHeader (64 bytes)
+ *   then four columns of count = N + 2 entries each ([start, wp1..wpN, terminal]),
+ *   every column starting on a 64-byte boundary:
+ *     x, y, penalty   float64, or float32 when kBinaryRouteFloat32 is set
+ *     prefix          always float64, penalty prefix sums as used by the solver
+ *
+ * float64 files are handed to the solver straight from the mapping.
+ */
+constexpr char kBinaryRouteMagic[8] = { 'U', 'A', 'V', 'R', 'O', 'U', 'T', 'E' };
+constexpr std::uint32_t kBinaryRouteVersion = 1;
+constexpr std::uint32_t kBinaryRouteFloat32 = 1u << 0;
+
+struct BinaryRouteHeader {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t flags;
+  double start_x, start_y;
+  double term_x, term_y;
+  std::uint64_t waypoint_count;  // N, excluding start and terminal
+  std::uint64_t reserved;
+};
+static_assert(sizeof(BinaryRouteHeader) == 64, "BinaryRouteHeader must stay 64 bytes");
+
+/**
+ * BinaryRouteView: columns of a binary route held in memory (usually a
+ * MappedFile). float64 columns point into the caller's buffer, which must
+ * outlive the view; float32 columns are widened into an owned copy.
+ */
+class BinaryRouteView {
+public:
+  bool open(const char* data, std::size_t size, std::string& error);
+  const WaypointColumns& columns() const { return columns_; }
+
+private:
+  WaypointColumns columns_;
+  WaypointSoA widened_;
+};
+
+bool isBinaryRoute(const char* data, std::size_t size);
+bool writeBinaryRoute(const WaypointColumns& cols, const std::string& path, bool float32, std::string& error);
+int convertTextToBinary(const std::string& input_file_name, const std::string& output_file_name, bool float32);
@@ -0,0 +1,124 @@
+#include "cost_model.h"
+#include "mapped_file.h"
+#include <charconv>
+
+namespace {
+
+/**
+ * @brief Parses the next whitespace-separated number of [pos, end)
+ */
+template <typename T>
+bool nextNumber(const char*& pos, const char* end, T& value)
+{
+  while (pos < end && (*pos == ' ' || *pos == '\t' || *pos == '\r' || *pos == '\n')) ++pos;
+  const char* first = pos;
+  if (first < end && *first == '+') ++first;  // from_chars rejects a leading '+'
+  const auto [ptr, ec] = std::from_chars(first, end, value);
+  if (ec != std::errc() || ptr == first) return false;
+  pos = ptr;
+  return true;
+}
+
+} // namespace
+
+
+const char* costModelName(CostModelKind kind)
+{
+  switch (kind) {
+  case CostModelKind::Manhattan:      return "manhattan";
+  case CostModelKind::DistanceMatrix: return "matrix";
+  case CostModelKind::TimeDependent:  return "speed-profile";
+  case CostModelKind::Euclidean:      break;
+  }
+  return "euclidean";
+}
+
+/**
+ * @brief Loads a distance matrix for CostModelKind::DistanceMatrix
+ *
+ * Text layout (whitespace separated): M, then M * M non-negative distances,
+ * row j holding the distances from point j to every point i. Points are
+ * numbered like the route: 0 = start, 1..N = waypoints, N + 1 = terminal,
+ * so M = N + 2.
+ *
+ * @param path  Matrix file
+ * @param model Receives the matrix; its kind is set to DistanceMatrix
+ * @param error Receives a description of the problem on failure
+ * @return bool true on success
+ */
+bool loadDistanceMatrix(const std::string& path, CostModel& model, std::string& error)
+{
+  MappedFile file;
+  if (!file.open(path)) {
+    error = "cannot open distance matrix " + path;
+    return false;
+  }
+  const char* pos = file.data();
+  const char* end = pos + file.size();
+  long long size = 0;
+  if (!nextNumber(pos, end, size) || size < 2 || size > (1 << 16)) {
+    error = "distance matrix " + path + ": expected the number of points (2..65536)";
+    return false;
+  }
+
+  model.kind = CostModelKind::DistanceMatrix;
+  model.matrix_size = (int)size;
+  model.distances.resize((std::size_t)size * size);
+  for (std::size_t k = 0; k < model.distances.size(); ++k) {
+    if (!nextNumber(pos, end, model.distances[k]) || !(model.distances[k] >= 0.0)) {
+      error = "distance matrix " + path + ": expected non-negative distance " + std::to_string(k / size) +
+        " -> " + std::to_string(k % size);
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Parses a speed profile for CostModelKind::TimeDependent
+ *
+ * Comma-separated start:speed pairs, e.g. "0:2,600:1.5,1800:2" (route time
+ * in seconds, skipped penalties included, see SpeedChange; speed until the
+ * next change). Starts must increase, the first
+ * must be 0 and every speed must be positive.
+ *
+ * @param list  Profile text
+ * @param model Receives the profile; its kind is set to TimeDependent
+ * @param error Receives a description of the problem on failure
+ * @return bool true on success
+ */
+bool parseSpeedProfile(const std::string& list, CostModel& model, std::string& error)
+{
+  model.kind = CostModelKind::TimeDependent;
+  model.speed_profile.clear();
+  size_t begin = 0;
+  while (begin <= list.size()) {
+    const size_t end = std::min(list.find(',', begin), list.size());
+    const std::string pair = list.substr(begin, end - begin);
+    const size_t colon = pair.find(':');
+    SpeedChange change{ 0.0, 0.0 };
+    bool valid = colon != std::string::npos;
+    if (valid) {
+      const char* pos = pair.data();
+      const char* separator = pair.data() + colon;
+      valid = nextNumber(pos, separator, change.start) && pos == separator;
+      pos = separator + 1;
+      valid = valid && nextNumber(pos, pair.data() + pair.size(), change.speed) && pos == pair.data() + pair.size();
+    }
+    if (!valid) {
+      error = "invalid speed profile entry '" + pair + "' (expected start:speed)";
+      return false;
+    }
+    if (!(change.speed > 0.0)) {
+      error = "invalid speed profile entry '" + pair + "' (speed must be > 0)";
+      return false;
+    }
+    if (model.speed_profile.empty() ? change.start != 0.0 : !(change.start > model.speed_profile.back().start)) {
+      error = "invalid speed profile entry '" + pair + "' (starts must increase from 0)";
+      return false;
+    }
+    model.speed_profile.push_back(change);
+    begin = end + 1;
+  }
+  return true;
+}
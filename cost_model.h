@@ -0,0 +1,148 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+/**
+ * CostModelKind: travel time model of the baseline and pruned solvers.
+ * - Euclidean:      straight-line distance / speed (default).
+ * - Manhattan:      (|dx| + |dy|) / speed, e.g. for grid-aligned corridors.
+ * - DistanceMatrix: precomputed distances between every pair of points / speed.
+ * - TimeDependent:  straight-line distance flown at a speed that changes
+ *                   over route time (piecewise-constant speed profile).
+ */
+enum class CostModelKind {
+  Euclidean,
+  Manhattan,
+  DistanceMatrix,
+  TimeDependent
+};
+
+/**
+ * SpeedChange: from route time `start` on, the UAV flies at `speed` until
+ * the next change. Route time is the objective accumulated so far: travel,
+ * waits and the penalties of the skipped waypoints, i.e. the DP value of the
+ * departure point. It runs ahead of the pure flight clock by the skipped
+ * penalties; with a flight clock every point would need a second label
+ * (elapsed flight time) next to its objective, and the DP over one value per
+ * point would no longer be exact.
+ */
+struct SpeedChange {
+  double start;
+  double speed;
+};
+
+/**
+ * CostModel: runtime description of the travel time model, turned into one
+ * of the policies below by dispatchCostModel().
+ * - distances: row-major matrix_size x matrix_size distances from point j
+ *   (row) to point i (column), for DistanceMatrix.
+ * - speed_profile: speed changes sorted by start, the first at 0, for TimeDependent.
+ */
+struct CostModel {
+  CostModelKind kind = CostModelKind::Euclidean;
+  std::vector<double> distances;
+  int matrix_size = 0;
+  std::vector<SpeedChange> speed_profile;
+};
+
+/**
+ * Cost policies: travel time from point j at (xj, yj), departing at route
+ * time `depart` (dp[j], see SpeedChange), to point i at (xi, yi). Every policy is a small value type whose
+ * travelTime() inlines into the solver loops; arguments a policy does not use
+ * are optimized away. Travel times must be non-negative (the pruned solver's
+ * bound relies on it). minTravelTime(dx, dy) is a lower bound of travelTime()
+ * for every pair at least dx apart in x and dy apart in y, at any departure
+ * time (the spatial solver's block bound).
+ */
+struct EuclideanCost {
+  double inv_speed;  // 1 / speed, folded into the hot loop instead of a division
+
+  explicit EuclideanCost(double speed) : inv_speed(1.0 / speed) {}
+  double travelTime(double xj, double yj, double xi, double yi, int, int, double) const
+  {
+    return std::hypot(xi - xj, yi - yj) * inv_speed;
+  }
+  double minTravelTime(double dx, double dy) const { return std::hypot(dx, dy) * inv_speed; }
+};
+
+struct ManhattanCost {
+  double inv_speed;
+
+  explicit ManhattanCost(double speed) : inv_speed(1.0 / speed) {}
+  double travelTime(double xj, double yj, double xi, double yi, int, int, double) const
+  {
+    return (std::fabs(xi - xj) + std::fabs(yi - yj)) * inv_speed;
+  }
+  double minTravelTime(double dx, double dy) const { return (dx + dy) * inv_speed; }
+};
+
+struct DistanceMatrixCost {
+  const double* distances;
+  int size;
+  double inv_speed;
+
+  DistanceMatrixCost(const CostModel& model, double speed)
+    : distances(model.distances.data()), size(model.matrix_size), inv_speed(1.0 / speed) {}
+  double travelTime(double, double, double, double, int j, int i, double) const
+  {
+    return distances[(std::size_t)j * size + i] * inv_speed;
+  }
+  double minTravelTime(double, double) const { return 0.0; }  // distances are unrelated to x/y
+};
+
+struct TimeDependentCost {
+  const SpeedChange* profile;
+  int changes;
+  double max_speed = 0.0;
+
+  explicit TimeDependentCost(const CostModel& model)
+    : profile(model.speed_profile.data()), changes((int)model.speed_profile.size())
+  {
+    for (int k = 0; k < changes; ++k) max_speed = std::max(max_speed, profile[k].speed);
+  }
+  double minTravelTime(double dx, double dy) const { return std::hypot(dx, dy) / max_speed; }
+
+  // Flies the distance through the speed segments from route time `depart` on
+  double travelTime(double xj, double yj, double xi, double yi, int, int, double depart) const
+  {
+    double remaining = std::hypot(xi - xj, yi - yj);
+    int k = (int)(std::upper_bound(profile, profile + changes, depart,
+      [](double t, const SpeedChange& c) { return t < c.start; }) - profile) - 1;
+    k = std::max(k, 0);
+    double t = depart;
+    for (;; ++k) {
+      const double segment_end = k + 1 < changes ? profile[k + 1].start : std::numeric_limits<double>::infinity();
+      const double reach = (segment_end - t) * profile[k].speed;
+      if (remaining <= reach) return t + remaining / profile[k].speed - depart;
+      remaining -= reach;
+      t = segment_end;
+    }
+  }
+};
+
+/**
+ * @brief Calls fn(policy) with the policy instance described by `model`
+ *        (nullptr = Euclidean): the runtime dispatcher over the compile-time
+ *        specialized solver variants.
+ */
+template <typename Fn>
+auto dispatchCostModel(const CostModel* model, double speed, Fn&& fn)
+{
+  if (model) {
+    switch (model->kind) {
+    case CostModelKind::Manhattan:      return fn(ManhattanCost(speed));
+    case CostModelKind::DistanceMatrix: return fn(DistanceMatrixCost(*model, speed));
+    case CostModelKind::TimeDependent:  return fn(TimeDependentCost(*model));
+    case CostModelKind::Euclidean:      break;
+    }
+  }
+  return fn(EuclideanCost(speed));
+}
+
+const char* costModelName(CostModelKind kind);
+bool loadDistanceMatrix(const std::string& path, CostModel& model, std::string& error);
+bool parseSpeedProfile(const std::string& list, CostModel& model, std::string& error);
@@ -1,13 +1,128 @@
 ﻿#include "delivery_uav.h"
+#include "cost_model.h"
+#include "path_utils.h"
+#include "precision_policy.h"
+#include "result_cache.h"
+#include "result_writer.h"
+#include "route_file.h"
+#include "simd_kernels.h"
+#include "solve_profile.h"
+#include "solve_workspace.h"
+#include "thread_pool.h"
+#include "waypoint_soa.h"
 #include <algorithm>
 #include <cmath>
-#include <iomanip>
 #include <iostream>
 #include <limits>
+#include <stdexcept>
 #include <chrono>
+#include <thread>
+#include <type_traits>
 
 WayPoint::WayPoint(double x_, double y_, double p_) : x(x_), y(y_), penalty(p_) {}
 
+namespace {
+
+// Rows with fewer predecessors than this are relaxed on the calling thread:
+// below it, waking the pool costs more than the vector kernel itself.
+constexpr int kDefaultParallelThreshold = 16384;
+
+/**
+ * @brief Content hash of a cost model for the result cache: equal models
+ *        hash alike wherever they are allocated (0 = Euclidean)
+ */
+std::uint64_t hashCostModel(const CostModel* model)
+{
+  if (!model || model->kind == CostModelKind::Euclidean) return 0;
+  static_assert(sizeof(SpeedChange) == 2 * sizeof(double), "SpeedChange is hashed as raw bytes");
+  const std::uint64_t parts[4] = {
+    static_cast<std::uint64_t>(model->kind) + 1,
+    static_cast<std::uint64_t>(model->matrix_size),
+    hashRouteBytes(model->distances.data(), model->distances.size() * sizeof(double)),
+    hashRouteBytes(model->speed_profile.data(), model->speed_profile.size() * sizeof(SpeedChange)),
+  };
+  return hashRouteBytes(parts, sizeof(parts));
+}
+
+/**
+ * @brief reconstructPath() timed as SolvePhase::Reconstruct when profiling
+ */
+void reconstructPath(const std::vector<int>& prev_waypoint, int terminal, std::vector<int>& path,
+  SolveStats& stats, bool profiling)
+{
+  PhaseTimer timer(phaseSink(stats, SolvePhase::Reconstruct, profiling));
+  ::reconstructPath(prev_waypoint, terminal, path);
+}
+
+/**
+ * @brief Relaxes row i of the bounded-skip DP over the last `window`
+ *        predecessors, whose DP values are stored in ring[j % window]
+ *
+ * Ascending scan with a strict '<', i.e. the smallest j wins ties as in
+ * DeliveryUAV::solve(). Shared by the forward pass and the checkpoint
+ * recomputation so that both perform exactly the same arithmetic.
+ */
+RelaxResult relaxWindowRow(const WaypointColumns& cols, const double* ring, int window, int i, const EuclideanCost& cost)
+{
+  RelaxResult best{ std::numeric_limits<double>::max(), -1 };
+  const int j_begin = std::max(0, i - window);
+  const double penalties_before_i = cols.prefix[i - 1];
+
+  int slot = j_begin % window;
+  for (int j = j_begin; j < i; ++j) {
+    const double travel = cost.travelTime(cols.x[j], cols.y[j], cols.x[i], cols.y[i], j, i, ring[slot]);
+    const double sum_pen = penalties_before_i - cols.prefix[j];
+    const double time_candidate = ring[slot] + travel + sum_pen;
+    if (time_candidate < best.min_time) {
+      best.min_time = time_candidate;
+      best.best_prev = j;
+    }
+    if (++slot == window) slot = 0;
+  }
+  return best;
+}
+
+/**
+ * @brief Exhaustive DP rows in tiles of `tile` rows by `tile` predecessors
+ *
+ * Rows are taken in tiles [i0, i1). Every predecessor below i0 is final, so
+ * the tile first sweeps them in predecessor tiles [j0, j1): each row of the
+ * tile is relaxed against the same j-tile, which stays in L1/L2 instead of
+ * being streamed from memory once per row, and keeps its running minimum in
+ * `best`. Then the rows are finished in order against [i0, i) (the triangle
+ * inside the tile, whose dp values become final row by row). Predecessor
+ * tiles run in ascending order and are merged with isBetterRelax, so the
+ * result is that of one relax(i, 0, i) call per row.
+ *
+ * @param relax  relax(i, j_begin, j_end) -> RelaxResult over [j_begin, j_end)
+ * @param finish finish(i, best) stores the final row i
+ */
+template <typename Relax, typename Finish>
+void relaxTiled(int total_points, int tile, std::vector<RelaxResult>& best, Relax&& relax, Finish&& finish)
+{
+  best.resize(tile);
+  // Tiles are aligned to multiples of `tile` (the first one starts at row 1),
+  // so that every predecessor tile below i0 is a full one
+  for (int i0 = 1, i1; i0 <= total_points; i0 = i1) {
+    i1 = std::min(total_points + 1, (i0 / tile + 1) * tile);
+    std::fill(best.begin(), best.begin() + (i1 - i0), RelaxResult{ std::numeric_limits<double>::max(), -1 });
+    for (int j0 = 0; j0 < i0; j0 += tile) {
+      const int j1 = std::min(i0, j0 + tile);
+      for (int i = i0; i < i1; ++i) {
+        const RelaxResult partial = relax(i, j0, j1);
+        if (isBetterRelax(partial, best[i - i0])) best[i - i0] = partial;
+      }
+    }
+    for (int i = i0; i < i1; ++i) {
+      const RelaxResult partial = relax(i, i0, i);
+      if (isBetterRelax(partial, best[i - i0])) best[i - i0] = partial;
+      finish(i, best[i - i0]);
+    }
+  }
+}
+
+} // namespace
+
 /**
  * @brief Constructs a DeliveryUAV instance with specified movement parameters
  *
@@ -25,20 +140,346 @@ WayPoint::WayPoint(double x_, double y_, double p_) : x(x_), y(y_), penalty(p_)
  *                 - Includes package delivery and system checks
  *                 - Applied to ALL visited waypoints including terminal
  *
+ * @param threads   Number of threads used by SolverMode::Parallel
+ *                 - 1 (default) solves on the calling thread only
+ *                 - 0 uses every hardware thread of the machine
+ *                 - The pool is created once and reused by every solveCase
+ *
  * Example usage:
  * @code
  * DeliveryUAV heavyPayloadDrone(5.0, 15.0);  // Slow speed, long setup time
  * DeliveryUAV racingDrone(25.0, 2.5);        // Fast speed, quick stops
+ * DeliveryUAV surveyDrone(10.0, 5.0, 0);     // Parallel solves on all cores
  * @endcode
  */
-DeliveryUAV::DeliveryUAV(double speed, double wait_time)
+DeliveryUAV::DeliveryUAV(double speed, double wait_time, int threads)
   : uav_speed_(speed),      // Initialized first - critical for calculations
-  wait_time_(wait_time)   // Directly affects all waypoint time costs
+  wait_time_(wait_time),  // Directly affects all waypoint time costs
+  simd_level_(detectSimdLevel()),
+  precision_(Precision::Double),
+  output_format_(OutputFormat::Text),
+  parallel_threshold_(kDefaultParallelThreshold)
 {
   // Note: While not explicitly validated here, these values should be:
   // - speed > 0 (prevents division-by-zero in time calculations)
   // - wait_time >= 0 (negative wait times are non-physical)
   // Caller responsibility to ensure valid parameters
+  if (threads == 0) threads = (int)std::max(1u, std::thread::hardware_concurrency());
+  if (threads > 1) pool_ = std::make_unique<ThreadPool>(threads);
+  executor_ = pool_.get();
+}
+
+DeliveryUAV::~DeliveryUAV() = default;
+DeliveryUAV::DeliveryUAV(DeliveryUAV&&) noexcept = default;
+DeliveryUAV& DeliveryUAV::operator=(DeliveryUAV&&) noexcept = default;
+
+/**
+ * @brief Selects the DP relaxation used by subsequent calls to solveCase
+ *
+ * @param mode Solver to use, see SolverMode (default: SolverMode::Baseline)
+ */
+void DeliveryUAV::setSolverMode(SolverMode mode)
+{
+  solver_mode_ = mode;
+}
+
+/**
+ * @brief Restricts the vector kernel used by SolverMode::Simd
+ *
+ * Defaults to the widest kernel supported by the running CPU. Requests above
+ * that level are clamped, so forcing SimdLevel::Scalar is always possible and
+ * is useful for checking the vector kernels against the scalar reference.
+ *
+ * @param level Highest instruction set the solver may use
+ */
+void DeliveryUAV::setSimdLevel(SimdLevel level)
+{
+  const SimdLevel supported = detectSimdLevel();
+  simd_level_ = (static_cast<int>(level) > static_cast<int>(supported)) ? supported : level;
+}
+
+SimdLevel DeliveryUAV::simdLevel() const
+{
+  return simd_level_;
+}
+
+/**
+ * @brief Selects the coordinate precision of SolverMode::Simd
+ *
+ * Precision::Float and Precision::Fixed re-encode the coordinates (float, or
+ * int32 on a power-of-two grid) and compute the distances in that format;
+ * DP values and penalties stay double. The result may differ from the double
+ * reference, see verifyPrecision(). Other solvers always use double.
+ *
+ * @param precision Coordinate precision (default: Precision::Double)
+ */
+void DeliveryUAV::setPrecision(Precision precision)
+{
+  precision_ = precision;
+}
+
+/**
+ * @brief Selects the travel time model of the baseline and pruned solvers
+ *
+ * Each CostModelKind is a compile-time policy of solve() and solvePruned(),
+ * selected per solve by dispatchCostModel(), so the default Euclidean model
+ * keeps its fully inlined loop. The other solvers implement the Euclidean
+ * model only; with any other model, solveRoute() runs the baseline solver
+ * unless SolverMode::Pruned is selected.
+ *
+ * @param model Shared, immutable model (nullptr = Euclidean, the default)
+ */
+void DeliveryUAV::setCostModel(std::shared_ptr<const CostModel> model)
+{
+  cost_model_ = std::move(model);
+  cost_model_hash_ = hashCostModel(cost_model_.get());
+}
+
+/**
+ * @brief Selects the layout of the solution file written by solveCase
+ *
+ * @param format OutputFormat::Text (default, human-readable report) or
+ *               OutputFormat::Binary (compact varint record, see ResultWriter)
+ */
+void DeliveryUAV::setOutputFormat(OutputFormat format)
+{
+  output_format_ = format;
+}
+
+/**
+ * @brief Enables the phase timers and memory counters of solveCase
+ *
+ * When disabled (default) no clock is read beyond the execution time of the
+ * report, so the solvers run exactly as without instrumentation.
+ *
+ * @param enabled       Time every SolvePhase in microseconds and record the
+ *                      peak resident memory in SolveStats
+ * @param write_sidecar Also write the statistics of each case as JSON to
+ *                      `<output_file_name>.stats.json`
+ */
+void DeliveryUAV::setProfiling(bool enabled, bool write_sidecar)
+{
+  profiling_ = enabled || write_sidecar;
+  stats_sidecar_ = write_sidecar;
+}
+
+/**
+ * @brief Sets the longest run of consecutive skipped waypoints allowed by
+ *        SolverMode::Window
+ *
+ * Predecessor j of waypoint i skips the i - j - 1 waypoints between them, so
+ * only j in [i - max_skip - 1, i - 1] is considered. With max_skip >= N the
+ * window solver returns the same result as SolverMode::Baseline.
+ *
+ * @param max_skip Maximum number of consecutive skipped waypoints (>= 0)
+ */
+void DeliveryUAV::setMaxSkip(int max_skip)
+{
+  max_skip_ = std::max(0, max_skip);
+}
+
+/**
+ * @brief Sets the number of consecutive predecessors per bounding box of
+ *        SolverMode::Spatial
+ *
+ * Smaller blocks give tighter boxes but more bound checks per row; the
+ * result does not depend on the block size.
+ *
+ * @param block_size Points per block (>= 1)
+ */
+void DeliveryUAV::setBlockSize(int block_size)
+{
+  block_size_ = std::max(1, block_size);
+}
+
+/**
+ * @brief Makes SolverMode::Simd evaluate the DP in tiles of tile_size rows
+ *        by tile_size predecessors (see relaxTiled())
+ *
+ * Each predecessor tile is reused by all rows of a row tile while it is in
+ * cache, so long routes read the columns N / tile_size times instead of N
+ * times. Results are identical to the untiled solver.
+ *
+ * @param tile_size Rows and predecessors per tile (0 = untiled)
+ */
+void DeliveryUAV::setTileSize(int tile_size)
+{
+  tile_size_ = std::max(0, tile_size);
+}
+
+/**
+ * @brief Installs the scratch buffers used by subsequent solves
+ *
+ * By default every thread solves with its own workspace, which keeps
+ * solveCase safe to call concurrently. An installed workspace is shared by
+ * all callers, so it must only be used with one solve at a time.
+ *
+ * @param workspace Caller-owned workspace, or nullptr for per-thread ones
+ */
+void DeliveryUAV::setWorkspace(SolveWorkspace* workspace)
+{
+  workspace_ = workspace;
+}
+
+SolveWorkspace& DeliveryUAV::workspace() const
+{
+  thread_local SolveWorkspace thread_workspace;
+  return workspace_ ? *workspace_ : thread_workspace;
+}
+
+/**
+ * @brief Trades compute for memory in SolverMode::Window
+ *
+ * Instead of one predecessor link per waypoint, the window solver keeps
+ * periodic DP checkpoints and recomputes the path segment by segment (see
+ * solveWindowCheckpointed()). The result is unchanged. Has no effect on the
+ * other solvers, or with setStreaming(), whose input is not kept for the
+ * recomputation.
+ *
+ * @param enabled Use checkpointed reconstruction
+ */
+void DeliveryUAV::setLowMemory(bool enabled)
+{
+  low_memory_ = enabled;
+}
+
+/**
+ * @brief Makes solveCase overlap parsing and solving instead of loading the
+ *        whole route first
+ *
+ * Only text routes with SolverMode::Window or SolverMode::Pruned can be
+ * streamed: their bounds let the solver forget old predecessors, so memory
+ * follows the live frontier rather than N (see solveStreamCase()).
+ *
+ * @param enabled Stream the input of subsequent solveCase calls
+ */
+void DeliveryUAV::setStreaming(bool enabled)
+{
+  streaming_ = enabled;
+}
+
+/**
+ * @brief Makes solveCase read input files holding several concatenated
+ *        cases, solved in a parse / solve / write pipeline
+ *
+ * Every case is solved with the configured solver (and deadline); the
+ * solutions are written to the one output file in input order (see
+ * solveMultiCase()). Not available with top-k routes, a fleet or streaming.
+ *
+ * @param enabled Treat the input of subsequent solveCase calls as multi-case
+ */
+void DeliveryUAV::setMultiCase(bool enabled)
+{
+  multi_case_ = enabled;
+}
+
+/**
+ * @brief Makes solveCase report the k best distinct routes instead of one
+ *
+ * The best route is written as before; routes 2..k follow the text report
+ * as "Alternative" blocks (see solveTopRoutes()). Values below 1 mean 1.
+ *
+ * @param k Number of routes per case
+ */
+void DeliveryUAV::setTopRoutes(int k)
+{
+  top_routes_ = std::max(1, k);
+}
+
+/**
+ * @brief Makes solveCase return the best route found within a time budget
+ *        instead of always finishing the exact DP (see solveWithinDeadline())
+ *
+ * The budget counts from the start of the DP; loading and writing the case
+ * are not included. SolveStats::proven_optimal and optimality_gap report
+ * the outcome.
+ *
+ * @param budget_ms Time budget in milliseconds (0 = no deadline)
+ */
+void DeliveryUAV::setDeadline(double budget_ms)
+{
+  deadline_ms_ = std::max(0.0, budget_ms);
+}
+
+/**
+ * @brief Makes solveCase split each route across a fleet of drones instead
+ *        of flying it with one UAV (see solveFleet())
+ *
+ * The text report then starts with the fleet objective as the minimum time
+ * and every visited waypoint, followed by one "Drone" block per drone.
+ * Values below 1 mean 1 (a single UAV).
+ *
+ * @param drones    Number of drones
+ * @param objective Minimized value: total flying time or makespan
+ */
+void DeliveryUAV::setFleet(int drones, FleetObjective objective)
+{
+  fleet_drones_ = std::max(1, drones);
+  fleet_objective_ = objective;
+}
+
+/**
+ * @brief Answers repeated routes of solveCase from a result cache
+ *
+ * The cache may be shared by several UAVs and threads; results of different
+ * parameters are kept apart by cacheParams(). Top-K reports bypass the cache,
+ * and deadline-bounded routes are only stored when proven optimal.
+ *
+ * @param cache Shared cache, or nullptr to disable caching
+ */
+void DeliveryUAV::setResultCache(std::shared_ptr<ResultCache> cache)
+{
+  result_cache_ = std::move(cache);
+}
+
+/**
+ * @brief Cache parameters of this UAV: speed, wait time and the settings
+ *        that may change the time or path of a route (solver, skip cap of
+ *        the window solver, coordinate precision, cost model contents)
+ */
+ResultCacheParams DeliveryUAV::cacheParams() const
+{
+  ResultCacheParams params;
+  params.speed = uav_speed_;
+  params.wait_time = wait_time_;
+  params.solver = static_cast<int>(solver_mode_);
+  params.max_skip = solver_mode_ == SolverMode::Window ? max_skip_ : 0;
+  params.precision = static_cast<int>(precision_);
+  params.cost_model = cost_model_hash_;
+  return params;
+}
+
+/**
+ * @brief Sets the smallest row that SolverMode::Parallel splits across threads
+ *
+ * Waypoint i has i candidate predecessors; rows with fewer candidates than
+ * min_predecessors are relaxed serially because the fork-join handshake
+ * would cost more than it saves.
+ *
+ * @param min_predecessors Row length from which the pool is used (>= 1)
+ */
+void DeliveryUAV::setParallelThreshold(int min_predecessors)
+{
+  parallel_threshold_ = std::max(1, min_predecessors);
+}
+
+int DeliveryUAV::threads() const
+{
+  return executor_ ? executor_->concurrency() : 1;
+}
+
+/**
+ * @brief Routes the row splitting of SolverMode::Parallel to another executor
+ *
+ * Used by batch mode so that large cases split their rows across the same
+ * work-stealing pool that solves the other cases, instead of a private pool.
+ * The executor must outlive every solve that uses it.
+ *
+ * @param executor External executor, or nullptr to restore the UAV's own pool
+ */
+void DeliveryUAV::setExecutor(ParallelExecutor* executor)
+{
+  executor_ = executor ? executor : pool_.get();
 }
 
 
@@ -55,86 +496,135 @@ DeliveryUAV::DeliveryUAV(double speed, double wait_time)
  *
  * @param input_file_name Path to input file containing single test case data
  * @param output_file_name Path to output file for writing results
+ * @param stats Optional sink for solver counters (candidates evaluated)
  * @return int Status code: 0 for success, 1 for errors
  *
  * @throws Does not throw exceptions but writes errors to cerr
  *
+ * Thread safety: solveCase only reads the UAV's configuration, so a single
+ * instance may solve different cases from several threads at once.
+ *
  * File Format Requirements:
- * - First line: Number of waypoints (N ≥ 0)
- * - Next 2 lines: Start coordinates and Terminal coordinates
+ * - First 2 lines: Start coordinates and Terminal coordinates
+ * - Next line: Number of waypoints (N ≥ 0)
  * - N lines: Waypoint data (X, Y, Penalty)
+ * Malformed numbers, a waypoint count that does not match N, or trailing
+ * data are reported on cerr together with the offending line number.
+ * Files in the binary route format (see binary_route.h) are recognized by
+ * their magic bytes and solved without any parsing. With setStreaming(true)
+ * the case is handed to solveStreamCase(), and with setMultiCase(true) the
+ * file's cases to solveMultiCase(). With a result cache (see
+ * setResultCache()), a route whose bytes were solved before is written from
+ * the cache without being parsed.
  */
 int DeliveryUAV::solveCase(
   const std::string& input_file_name,
-  const std::string& output_file_name)
+  const std::string& output_file_name,
+  SolveStats* stats) const
 {
+  if (multi_case_) return solveMultiCase(input_file_name, output_file_name, stats);
+  if (streaming_) return solveStreamCase(input_file_name, output_file_name, stats);
 
   // ----------------------
   // Satrt Timer
   // ----------------------
 	auto start_time = std::chrono::high_resolution_clock::now();
+  SolveStats case_stats;
 
   // ----------------------
-  // File Initialization 
+  // File Initialization and Waypoint Data Loading
   // ----------------------
-  std::ifstream input_file(input_file_name);
-  if (!input_file.is_open()) {
-    std::cerr << "Error opening input file: " << input_file_name << '\n';
+  // Binary routes are used in place from the mapping; text files are parsed
+  // straight into SoA columns, computing the penalty prefix sums
+  // (prefix[N+1] = prefix[N], no terminal penalty)
+  SolveWorkspace& ws = workspace();
+  PhaseTimer load_timer(phaseSink(case_stats, SolvePhase::Load, profiling_));
+  RouteFile& input_file = ws.input;
+  std::string load_error;
+  if (!input_file.map(input_file_name, load_error)) {
+    std::cerr << load_error << '\n';
+    return EXIT_FAILURE;
+  }
+  // A repeated route is answered from the result cache before it is parsed
+  std::vector<int>& optimal_path = ws.path;
+  double result = 0.0;
+  ResultCacheKey cache_key;
+  const bool use_cache = result_cache_ && top_routes_ == 1 && fleet_drones_ == 1;
+  const bool cache_hit = use_cache &&
+    result_cache_->find(input_file.data(), input_file.size(), cacheParams(), cache_key, result, optimal_path);
+  // Parsing a text route unmaps it, so a miss keeps its bytes for store()
+  std::vector<char>& cache_route = ws.cache_route;
+  if (use_cache && !cache_hit) cache_route.assign(input_file.data(), input_file.data() + input_file.size());
+  if (!cache_hit && !input_file.load(input_file_name, load_error)) {
+    std::cerr << load_error << '\n';
     return EXIT_FAILURE;
   }
+  const WaypointColumns& cols = input_file.columns();
+  load_timer.stop();
 
-  std::ofstream output_file(output_file_name);
+  PhaseTimer open_output_timer(phaseSink(case_stats, SolvePhase::OpenOutput, profiling_));
+  std::ofstream output_file(output_file_name,
+    output_format_ == OutputFormat::Binary ? std::ios::out | std::ios::binary : std::ios::out);
   if (!output_file.is_open()) {
     std::cerr << "Error opening output file: " << output_file_name << '\n';
-    input_file.close();  // Cleanup already opened input file
     return EXIT_FAILURE;
   }
-
-  // ----------------------
-  // Waypoint Data Loading 
-  // ----------------------
-  double start_x, start_y, term_x, term_y;
-  input_file >> start_x >> start_y >> term_x >> term_y;
-
-
-	// ----------------------
-  // Input Validation 
-  // ----------------------
-	int n = 0;
-	input_file >> n;
-	if (n < 0) {
-		std::cerr << "Invalid input format. Number of waypoints ("
-			<< n << ") must be non-negative.\n";
-		return EXIT_FAILURE;
-	}
-
-  // Initialize waypoints with start and terminal points
-  std::vector<WayPoint> waypoints;
-  waypoints.reserve(n + 2);  // Preallocate for N + start + terminal
-  waypoints.emplace_back(start_x, start_y, 0.0);  // Start point (index 0)
-
-  // Load N waypoints between start and terminal
-  for (int i = 0; i < n; ++i) {
-    double x, y, p;
-    input_file >> x >> y >> p;
-    waypoints.emplace_back(x, y, p);  // Main waypoints (indices 1..N)
-  }
-  waypoints.emplace_back(term_x, term_y, 0.0);  // Terminal point (index N+1)
-
-  // ----------------------
-  // Penalty Precomputation
-  // ----------------------
-  std::vector<double> prefix(n + 2, 0.0);  // prefix[0] = 0 (start point)
-  for (int i = 1; i <= n; ++i) {
-    prefix[i] = prefix[i - 1] + waypoints[i].penalty;
-  }
-  prefix[n + 1] = prefix[n];  // Terminal inherits previous sum (no penalty)
+  open_output_timer.stop();
 
   // ----------------------
   // Core Algorithm Execution
   // ----------------------
-  std::vector<int> optimal_path;
-  const double result = DeliveryUAV::solve(waypoints, prefix, optimal_path);
+  if (!cache_hit) {
+    if (cost_model_ && cost_model_->kind == CostModelKind::DistanceMatrix && cost_model_->matrix_size != cols.count) {
+      std::cerr << "Distance matrix has " << cost_model_->matrix_size << " points, " << input_file_name
+        << " has " << cols.count << " (start, waypoints and terminal)\n";
+      return EXIT_FAILURE;
+    }
+    if (fleet_drones_ > std::max(1, cols.count - 2)) {
+      std::cerr << "Cannot split the " << cols.count - 2 << " waypoints of " << input_file_name << " across "
+        << fleet_drones_ << " drones\n";
+      return EXIT_FAILURE;
+    }
+    SolveStats route_stats;
+    if (fleet_drones_ > 1) {
+      // The header lists every visited waypoint; the drones are appended below
+      solveFleet(cols, fleet_drones_, fleet_objective_, ws.fleet, &route_stats);
+      result = ws.fleet.objective;
+      optimal_path.assign(1, 0);
+      for (const DroneRoute& drone : ws.fleet.drones) {
+        optimal_path.insert(optimal_path.end(), drone.path.begin() + 1, drone.path.end() - 1);
+      }
+      optimal_path.push_back(cols.count - 1);
+    }
+    else if (top_routes_ > 1) {
+      // Best route first; the others are appended to the report below
+      solveTopRoutes(cols, top_routes_, ws.alternatives, &route_stats);
+      result = ws.alternatives[0].total_time;
+      optimal_path = ws.alternatives[0].path;
+    }
+    else if (deadline_ms_ > 0.0) {
+      AnytimeResult& anytime = ws.anytime;
+      solveWithinDeadline(cols, deadline_ms_, anytime, &route_stats);
+      result = anytime.total_time;
+      optimal_path = anytime.path;
+    }
+    else {
+      result = solveRoute(cols, optimal_path, &route_stats);
+    }
+    case_stats.candidates_evaluated = route_stats.candidates_evaluated;
+    case_stats.proven_optimal = route_stats.proven_optimal;
+    case_stats.optimality_gap = route_stats.optimality_gap;
+    case_stats.blocks_skipped = route_stats.blocks_skipped;
+    case_stats.phase_us[static_cast<int>(SolvePhase::Dp)] = route_stats.phase_us[static_cast<int>(SolvePhase::Dp)];
+    case_stats.phase_us[static_cast<int>(SolvePhase::Reconstruct)] =
+      route_stats.phase_us[static_cast<int>(SolvePhase::Reconstruct)];
+    // Deadline-bounded routes are only kept when proven optimal
+    if (use_cache && route_stats.proven_optimal)
+      result_cache_->store(cache_key, cache_route.data(), cache_route.size(), result, optimal_path);
+  }
+  case_stats.cache_hit = cache_hit;
+  case_stats.bytes_read = (long long)input_file.bytesRead();
+  input_file.close();
 
  // ----------------------
  // Stop timing
@@ -145,23 +635,228 @@ int DeliveryUAV::solveCase(
   // ----------------------
   // Result Output
   // ----------------------
-  output_file << "Execution Time: " << duration.count() << " ms\n";
-  output_file << "Minimum UAV time: " << std::fixed << std::setprecision(3) << result << '\n';
-  output_file << "Optimal waypoint indicies: \n";
-  for (int idx = 1; idx < optimal_path.size() - 1; idx++) {
-    output_file << optimal_path[idx] << " \n";
+  // Formatted into a per-thread buffer (reused across cases) and written at once
+  PhaseTimer output_timer(phaseSink(case_stats, SolvePhase::Output, profiling_));
+  thread_local ResultWriter writer;
+  if (output_format_ == OutputFormat::Binary) {
+    writer.formatBinary(duration.count(), result, optimal_path);
+  }
+  else {
+    writer.formatText(duration.count(), result, optimal_path);
+    for (std::size_t r = 1; top_routes_ > 1 && r < ws.alternatives.size(); ++r) {
+      writer.appendAlternative((int)r + 1, ws.alternatives[r].total_time, ws.alternatives[r].path);
+    }
+    for (std::size_t d = 0; fleet_drones_ > 1 && d < ws.fleet.drones.size(); ++d) {
+      writer.appendDrone((int)d + 1, ws.fleet.drones[d].total_time, ws.fleet.drones[d].path);
+    }
+  }
+  if (!writer.writeTo(output_file)) {
+    std::cerr << "Error writing output file: " << output_file_name << '\n';
+    return EXIT_FAILURE;
   }
 
   // -------------------
   // Resource Cleanup
   // -------------------
-  input_file.close();
   output_file.close();
+  output_timer.stop();
+
+  if (profiling_) {
+    case_stats.total_us = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::high_resolution_clock::now() - start_time).count();
+    case_stats.peak_rss_kb = peakResidentKiB();
+    if (stats_sidecar_ && !writeStatsJson(output_file_name + ".stats.json", input_file_name, case_stats)) {
+      std::cerr << "Error writing stats file: " << output_file_name << ".stats.json\n";
+      return EXIT_FAILURE;
+    }
+  }
+  if (stats) *stats = case_stats;
 
   return EXIT_SUCCESS;
 }
 
 
+/**
+ * @brief Solves a route that is already in memory with the configured solver
+ *
+ * Core of solveCase() without any file I/O; also used by the benchmark suite
+ * to time the solvers alone.
+ *
+ * @param cols  Columns of [start, wp1, wp2..., terminal] with penalty prefix sums
+ * @param path  Output vector storing indices of visited (optimal) waypoints in order
+ * @param stats Optional sink for solver counters (candidates evaluated)
+ * @return double Minimal total time in seconds to complete the course
+ */
+double DeliveryUAV::solveRoute(
+  const WaypointColumns& cols,
+  std::vector<int>& path,
+  SolveStats* stats) const
+{
+  const CostModel* cost_model = cost_model_.get();
+  if (cost_model && cost_model->kind == CostModelKind::DistanceMatrix && cost_model->matrix_size != cols.count) {
+    throw std::invalid_argument("distance matrix has " + std::to_string(cost_model->matrix_size) +
+      " points, the route has " + std::to_string(cols.count));
+  }
+  // Only the scalar solvers are specialized on the cost model
+  const bool custom_cost = cost_model && cost_model->kind != CostModelKind::Euclidean;
+  const SolverMode mode = custom_cost && solver_mode_ != SolverMode::Pruned && solver_mode_ != SolverMode::Separable &&
+    solver_mode_ != SolverMode::Spatial ? SolverMode::Baseline : solver_mode_;
+
+  SolveStats route_stats;
+  double result = 0.0;
+  PhaseTimer solve_timer(phaseSink(route_stats, SolvePhase::Dp, profiling_));
+  switch (mode) {
+  case SolverMode::Pruned:
+    result = dispatchCostModel(cost_model, uav_speed_, [&](const auto& cost) {
+      return solvePruned(cols, cost, path, route_stats);
+    });
+    break;
+  case SolverMode::Simd:
+    result = solveSimd(cols, path, route_stats);
+    break;
+  case SolverMode::Parallel:
+    result = solveParallel(cols, path, route_stats);
+    break;
+  case SolverMode::Window:
+    result = solveWindow(cols, path, route_stats);
+    break;
+  case SolverMode::Spatial:
+    result = solveSpatialBlocks(cols, path, route_stats);
+    break;
+  case SolverMode::Gpu:
+    result = solveGpu(cols, path, route_stats);
+    break;
+  case SolverMode::Separable:
+    if (solveSeparable(cols, path, route_stats, result)) break;
+    // Not separable: the pruned scan is the general fallback
+    result = dispatchCostModel(cost_model, uav_speed_, [&](const auto& cost) {
+      return solvePruned(cols, cost, path, route_stats);
+    });
+    break;
+  case SolverMode::Baseline: {
+    SolveWorkspace& ws = workspace();
+    toWayPoints(cols, ws.waypoints);
+    ws.prefix.assign(cols.prefix, cols.prefix + cols.count);
+    result = dispatchCostModel(cost_model, uav_speed_, [&](const auto& cost) {
+      return solve(ws.waypoints, ws.prefix, cost, path, route_stats);
+    });
+    break;
+  }
+  }
+  solve_timer.stop();
+  // The solvers time their own path reconstruction; Dp is the remainder
+  route_stats.phase_us[static_cast<int>(SolvePhase::Dp)] -=
+    route_stats.phase_us[static_cast<int>(SolvePhase::Reconstruct)];
+  if (stats) *stats = route_stats;
+  return result;
+}
+
+
+/**
+ * @brief Route view over separate x, y and penalty columns of N waypoints
+ */
+RouteInput RouteInput::fromColumns(double start_x, double start_y, double terminal_x, double terminal_y,
+  const double* x, const double* y, const double* penalty, std::size_t count)
+{
+  return { start_x, start_y, terminal_x, terminal_y, x, y, penalty, count, 1 };
+}
+
+/**
+ * @brief Route view over an array of N WayPoint structs (no copy)
+ */
+RouteInput RouteInput::fromWayPoints(double start_x, double start_y, double terminal_x, double terminal_y,
+  const WayPoint* waypoints, std::size_t count)
+{
+  static_assert(sizeof(WayPoint) == 3 * sizeof(double), "WayPoint must be three packed doubles");
+  return { start_x, start_y, terminal_x, terminal_y,
+    &waypoints->x, &waypoints->y, &waypoints->penalty, count, sizeof(WayPoint) / sizeof(double) };
+}
+
+
+/**
+ * @brief Solves an in-memory route without any file I/O
+ *
+ * Library entry point for embedding applications. The waypoints are staged
+ * once into the 64-byte aligned columns of the thread's workspace (the
+ * layout every solver reads, with the start and terminal points and the
+ * penalty prefix sums added) and solved by solveRoute(cols). The path and
+ * the optional segment breakdown are written into the caller's RouteResult,
+ * so a reused result and workspace make steady-state solves allocation free.
+ *
+ * @param route         Start, terminal and the N waypoints
+ * @param result        Receives the minimum time, the path and the segments
+ * @param with_segments Also fill result.segments (one entry per leg)
+ * @param stats         Optional sink for solver counters; staging is timed as
+ *                      SolvePhase::Load when profiling
+ * @throws std::invalid_argument for null columns, a zero stride or more
+ *         waypoints than an int index can address
+ */
+void DeliveryUAV::solveRoute(
+  const RouteInput& route,
+  RouteResult& result,
+  bool with_segments,
+  SolveStats* stats) const
+{
+  if (route.count > 0 && (!route.x || !route.y || !route.penalty || route.stride == 0)) {
+    throw std::invalid_argument("RouteInput: x, y and penalty must point to count values with a non-zero stride");
+  }
+  if (route.count > (std::size_t)std::numeric_limits<int>::max() - 2) {
+    throw std::invalid_argument("RouteInput: too many waypoints (" + std::to_string(route.count) + ")");
+  }
+
+  SolveStats route_stats;
+  long long load_us = 0;
+  WaypointSoA& soa = workspace().route;
+  {
+    PhaseTimer timer(profiling_ ? &load_us : nullptr);
+    const int n = (int)route.count;
+    soa.x.resize(n + 2);
+    soa.y.resize(n + 2);
+    soa.penalty.resize(n + 2);
+    soa.prefix.resize(n + 2);
+    soa.x[0] = route.start_x;
+    soa.y[0] = route.start_y;
+    soa.penalty[0] = 0.0;
+    soa.prefix[0] = 0.0;
+    double running = 0.0;
+    for (int k = 0; k < n; ++k) {
+      const std::size_t offset = (std::size_t)k * route.stride;
+      soa.x[k + 1] = route.x[offset];
+      soa.y[k + 1] = route.y[offset];
+      soa.penalty[k + 1] = route.penalty[offset];
+      running += route.penalty[offset];
+      soa.prefix[k + 1] = running;
+    }
+    soa.x[n + 1] = route.terminal_x;
+    soa.y[n + 1] = route.terminal_y;
+    soa.penalty[n + 1] = 0.0;
+    soa.prefix[n + 1] = running;  // Terminal inherits previous sum (no penalty)
+  }
+
+  result.total_time = solveRoute(soa.columns(), result.path, &route_stats);
+  route_stats.phase_us[static_cast<int>(SolvePhase::Load)] = load_us;
+
+  result.segments.clear();
+  if (with_segments) {
+    // Leg times are recomputed exactly as in the DP candidate expression
+    result.segments.reserve(result.path.size());
+    for (size_t k = 1; k < result.path.size(); ++k) {
+      const int from = result.path[k - 1];
+      const int to = result.path[k];
+      RouteSegment segment;
+      segment.from = from;
+      segment.to = to;
+      segment.distance = std::hypot(soa.x[to] - soa.x[from], soa.y[to] - soa.y[from]);
+      segment.flight_time = segment.distance / uav_speed_;
+      segment.skipped_penalty = soa.prefix[to - 1] - soa.prefix[from];
+      segment.wait_time = wait_time_;
+      result.segments.push_back(segment);
+    }
+  }
+  if (stats) *stats = route_stats;
+}
+
+
 /**
  * @brief Computes the minimal time required for the UAV to complete the course
  *        using dynamic programming with penalty optimization.
@@ -177,24 +872,33 @@ int DeliveryUAV::solveCase(
  *                  [start, wp1, wp2..., terminal]
  * @param prefix    Prefix sum array where prefix[i] represents the sum of
  *                  penalties from waypoints[1] to waypoints[i]
+ * @param cost      Cost model policy giving the travel time between two
+ *                  points (see cost_model.h); EuclideanCost by default
  * @param path      Output vector storing indices of visited (optimal) waypoints in order
+ * @param stats     Receives the number of candidate transitions evaluated
  * @return double   Minimal total time in seconds to complete the course,
  *                  rounded to 3 decimal places in the output
  */
+template <typename Cost>
 double DeliveryUAV::solve(
   const std::vector<WayPoint>& waypoints,
   const std::vector<double>& prefix,
-  std::vector<int>& path)
+  const Cost& cost,
+  std::vector<int>& path,
+  SolveStats& stats) const
 {
   // Total points includes all waypoints except terminal in initial calculation
   const int total_points = (int)waypoints.size() - 1;  // waypoints.size() = N + 2 (start + N + terminal)
 
   // DP array where dp[i] represents minimum time to reach waypoint[i]
-  std::vector<double> dp(total_points + 1, std::numeric_limits<double>::infinity());
+  SolveWorkspace& ws = workspace();
+  AlignedVector<double>& dp = ws.dp;
+  dp.assign(total_points + 1, std::numeric_limits<double>::infinity());
   dp[0] = 0.0;  // Base case: start point requires no initial time
 
   // vector to track best previous points for path reconstruction
-  std::vector<int> prev_waypoint(total_points + 1, -1);
+  std::vector<int>& prev_waypoint = ws.prev_waypoint;
+  prev_waypoint.assign(total_points + 1, -1);
 
   // Compute optimal path for each subsequent waypoint
   for (int i = 1; i <= total_points; ++i) {
@@ -203,15 +907,15 @@ double DeliveryUAV::solve(
     int bestPrev = -1;
     // Consider all possible previous waypoints j that could precede i
     for (int j = 0; j < i; ++j) {
-      // Calculate straight-line distance between waypoints j and i
-      const double distance = std::hypot(waypoints[i].x - waypoints[j].x,
-        waypoints[i].y - waypoints[j].y);
+      // Travel time from waypoint j to i under the cost model, departing at dp[j]
+      const double travel = cost.travelTime(waypoints[j].x, waypoints[j].y,
+        waypoints[i].x, waypoints[i].y, j, i, dp[j]);
 
       // Sum of penalties for skipped waypoints between j and i (wp[j+1] to wp[i-1])
       const double sum_pen = prefix[i - 1] - prefix[j];
 
       // Calculate candidate time: time to reach j + travel time + penalties
-      const double time_candidate = dp[j] + (distance / uav_speed_) + sum_pen;
+      const double time_candidate = dp[j] + travel + sum_pen;
 
       // Track minimum time across all possible j positions
       // min_time = std::min(min_time, time_candidate);
@@ -224,18 +928,424 @@ double DeliveryUAV::solve(
     // Add mandatory wait time at current waypoint (including terminal)
     dp[i] = min_time + wait_time_;
     prev_waypoint[i] = bestPrev;
+    stats.candidates_evaluated += i;
   }
 
-  // Reconstruct path
-  path.clear();
-  int current = total_points; // Start from terminal
+  reconstructPath(prev_waypoint, total_points, path, stats, profiling_);
+
+  // Final result is the minimal time to reach terminal point (last element)
+  return dp[total_points];
+}
+
+
+/**
+ * @brief Pruned variant of solve() that returns the same optimal time and path
+ *
+ * Every candidate can be written as
+ *   dp[j] + travel(j, i) + prefix[i-1] - prefix[j]
+ *     >= (dp[j] - prefix[j]) + prefix[i-1]
+ * since the travel term is non-negative under every cost model. Keeping the running minimum
+ * floor[j] = min(dp[k] - prefix[k]) over k <= j gives a lower bound for every
+ * predecessor at or before j. Scanning j downward from i-1, the scan stops as
+ * soon as floor[j] + prefix[i-1] exceeds the best candidate found so far:
+ * no smaller j can win. When visiting waypoints is worthwhile, dp[j] - prefix[j]
+ * keeps decreasing and only a few recent predecessors are evaluated per i.
+ *
+ * Ties are resolved towards the smallest j, exactly like the forward scan in
+ * solve(), so both functions produce identical paths.
+ *
+ * Time Complexity: O(N^2) worst case, close to O(N) for realistic penalties
+ *
+ * @param cols      Columns of [start, wp1, wp2..., terminal] with penalty
+ *                  prefix sums (see solve() for the prefix convention)
+ * @param cost      Cost model policy, as for solve()
+ * @param path      Output vector storing indices of visited (optimal) waypoints in order
+ * @param stats     Receives the number of candidate transitions evaluated
+ * @return double   Minimal total time in seconds to complete the course
+ */
+template <typename Cost>
+double DeliveryUAV::solvePruned(
+  const WaypointColumns& cols,
+  const Cost& cost,
+  std::vector<int>& path,
+  SolveStats& stats) const
+{
+  const int total_points = cols.count - 1;
+  const double* prefix = cols.prefix;
+
+  SolveWorkspace& ws = workspace();
+  AlignedVector<double>& dp = ws.dp;
+  dp.assign(total_points + 1, std::numeric_limits<double>::infinity());
+  dp[0] = 0.0;
+
+  // floor[j] = min over k <= j of (dp[k] - prefix[k])
+  std::vector<double>& floor = ws.floor;
+  floor.assign(total_points + 1, 0.0);
+  floor[0] = dp[0] - prefix[0];
+
+  std::vector<int>& prev_waypoint = ws.prev_waypoint;
+  prev_waypoint.assign(total_points + 1, -1);
+
+  for (int i = 1; i <= total_points; ++i) {
+    double min_time = std::numeric_limits<double>::max();
+    int bestPrev = -1;
+    const double penalties_before_i = prefix[i - 1];
+
+    for (int j = i - 1; j >= 0; --j) {
+      // Lower bound of every candidate k <= j; the relative slack absorbs
+      // rounding differences between the bound and the candidate expression
+      const double bound = floor[j] + penalties_before_i;
+      if (bound - min_time > 1e-12 * std::fabs(min_time)) break;
+
+      const double travel = cost.travelTime(cols.x[j], cols.y[j], cols.x[i], cols.y[i], j, i, dp[j]);
+      const double sum_pen = penalties_before_i - prefix[j];
+      const double time_candidate = dp[j] + travel + sum_pen;
+      ++stats.candidates_evaluated;
+
+      // '<=' while scanning downwards keeps the smallest j among equal times
+      if (time_candidate <= min_time) {
+        min_time = time_candidate;
+        bestPrev = j;
+      }
+    }
+
+    dp[i] = min_time + wait_time_;
+    prev_waypoint[i] = bestPrev;
+    floor[i] = std::min(floor[i - 1], dp[i] - prefix[i]);
+  }
+
+  reconstructPath(prev_waypoint, total_points, path, stats, profiling_);
+
+  return dp[total_points];
+}
+
+
+/**
+ * @brief Exhaustive DP over the structure-of-arrays layout using vector kernels
+ *
+ * Same recurrence as solve(), but every row i is relaxed by the kernel chosen
+ * at runtime (AVX-512, AVX2 or scalar, see setSimdLevel()). The kernels use
+ * sqrt(dx^2 + dy^2) instead of std::hypot, so times may differ from solve()
+ * in the last bits; the selected path uses the same smallest-index tie-break.
+ *
+ * Time Complexity: O(N^2 / W), W = 8 (AVX-512), 4 (AVX2) or 1 (scalar)
+ *
+ * @param cols  Columns of [start, wp1, wp2..., terminal] with penalty prefix sums
+ * @param path  Output vector storing indices of visited (optimal) waypoints in order
+ * @param stats Receives the number of candidate transitions evaluated
+ * @return double Minimal total time in seconds to complete the course
+ */
+double DeliveryUAV::solveSimd(
+  const WaypointColumns& cols,
+  std::vector<int>& path,
+  SolveStats& stats) const
+{
+  if (precision_ == Precision::Float) return solveScaled<FloatPolicy>(cols, workspace().float_coords, path, stats);
+  if (precision_ == Precision::Fixed) return solveScaled<FixedPolicy>(cols, workspace().fixed_coords, path, stats);
+
+  const int total_points = cols.count - 1;
+  const RelaxKernel relax = relaxKernelFor(simd_level_);
+
+  SolveWorkspace& ws = workspace();
+  AlignedVector<double>& dp = ws.dp;
+  dp.assign(total_points + 1, std::numeric_limits<double>::infinity());
+  dp[0] = 0.0;
+  std::vector<int>& prev_waypoint = ws.prev_waypoint;
+  prev_waypoint.assign(total_points + 1, -1);
+
+  if (tile_size_ > 0) {
+    relaxTiled(total_points, tile_size_, ws.best,
+      [&](int i, int j_begin, int j_end) { return relax(cols, dp.data(), i, j_begin, j_end, uav_speed_); },
+      [&](int i, const RelaxResult& best) {
+        dp[i] = best.min_time + wait_time_;
+        prev_waypoint[i] = best.best_prev;
+        stats.candidates_evaluated += i;
+      });
+  }
+  else {
+    for (int i = 1; i <= total_points; ++i) {
+      const RelaxResult best = relax(cols, dp.data(), i, 0, i, uav_speed_);
+      dp[i] = best.min_time + wait_time_;
+      prev_waypoint[i] = best.best_prev;
+      stats.candidates_evaluated += i;
+    }
+  }
+
+  reconstructPath(prev_waypoint, total_points, path, stats, profiling_);
+
+  return dp[total_points];
+}
+
+
+/**
+ * @brief solveSimd() with the coordinates re-encoded by a precision policy
+ *
+ * The coordinates are encoded once into `coords` (see encodeColumns) and
+ * every row is relaxed over them: FloatPolicy uses the float vector kernel
+ * of the selected SIMD level, FixedPolicy the scalar policy kernel. The DP
+ * and penalty sums are accumulated in double as in solveSimd().
+ *
+ * @param cols   Columns of [start, wp1, wp2..., terminal] with penalty prefix sums
+ * @param coords Workspace buffer receiving the encoded coordinates
+ * @param path   Output vector storing indices of visited (optimal) waypoints in order
+ * @param stats  Receives the number of candidate transitions evaluated
+ * @return double Minimal total time in seconds to complete the course
+ */
+template <typename Policy>
+double DeliveryUAV::solveScaled(
+  const WaypointColumns& cols,
+  ScaledColumns<typename Policy::Coord>& coords,
+  std::vector<int>& path,
+  SolveStats& stats) const
+{
+  const int total_points = cols.count - 1;
+  encodeColumns<Policy>(cols, coords);
+  ScaledRelaxKernel<typename Policy::Coord> relax = relaxScaled<Policy>;
+  if constexpr (std::is_same<Policy, FloatPolicy>::value) relax = floatRelaxKernelFor(simd_level_);
+
+  SolveWorkspace& ws = workspace();
+  AlignedVector<double>& dp = ws.dp;
+  dp.assign(total_points + 1, std::numeric_limits<double>::infinity());
+  dp[0] = 0.0;
+  std::vector<int>& prev_waypoint = ws.prev_waypoint;
+  prev_waypoint.assign(total_points + 1, -1);
+
+  if (tile_size_ > 0) {
+    relaxTiled(total_points, tile_size_, ws.best,
+      [&](int i, int j_begin, int j_end) { return relax(coords, cols.prefix, dp.data(), i, j_begin, j_end, uav_speed_); },
+      [&](int i, const RelaxResult& best) {
+        dp[i] = best.min_time + wait_time_;
+        prev_waypoint[i] = best.best_prev;
+        stats.candidates_evaluated += i;
+      });
+  }
+  else {
+    for (int i = 1; i <= total_points; ++i) {
+      const RelaxResult best = relax(coords, cols.prefix, dp.data(), i, 0, i, uav_speed_);
+      dp[i] = best.min_time + wait_time_;
+      prev_waypoint[i] = best.best_prev;
+      stats.candidates_evaluated += i;
+    }
+  }
+
+  reconstructPath(prev_waypoint, total_points, path, stats, profiling_);
+
+  return dp[total_points];
+}
+
+/**
+ * @brief Exhaustive DP that splits long rows across the UAV's executor (its
+ *        own thread pool, or the pool installed with setExecutor())
+ *
+ * The relaxation of row i is an independent min/argmin reduction over
+ * j in [0, i). Rows with at least parallel_threshold_ predecessors are cut
+ * into one contiguous chunk per thread; each chunk is reduced by the vector
+ * kernel into its own cache-line-padded slot, then the slots are merged in
+ * chunk order with the smallest-index tie-break. The result is therefore
+ * identical to solveSimd() for any thread count. Shorter rows, and every row
+ * when the UAV has no executor, stay on the calling thread.
+ *
+ * Time Complexity: O(N^2 / (W * T)) for T threads and vector width W
+ *
+ * @param cols  Columns of [start, wp1, wp2..., terminal] with penalty prefix sums
+ * @param path  Output vector storing indices of visited (optimal) waypoints in order
+ * @param stats Receives the number of candidate transitions evaluated
+ * @return double Minimal total time in seconds to complete the course
+ */
+double DeliveryUAV::solveParallel(
+  const WaypointColumns& cols,
+  std::vector<int>& path,
+  SolveStats& stats) const
+{
+  const int total_points = cols.count - 1;
+  const RelaxKernel relax = relaxKernelFor(simd_level_);
+  ParallelExecutor* executor = executor_;
+  const int chunks = threads();
+
+  SolveWorkspace& ws = workspace();
+  AlignedVector<double>& dp = ws.dp;
+  dp.assign(total_points + 1, std::numeric_limits<double>::infinity());
+  dp[0] = 0.0;
+  std::vector<int>& prev_waypoint = ws.prev_waypoint;
+  prev_waypoint.assign(total_points + 1, -1);
+  AlignedVector<PaddedRelaxResult>& partial = ws.partial;
+  partial.resize(chunks);
+
+  // Row shared with the chunk task; the task object is built once, not per
+  // row, and captures a single reference so std::function stores it inline
+  struct ChunkContext {
+    const WaypointColumns& cols;
+    const double* dp;
+    PaddedRelaxResult* partial;
+    RelaxKernel relax;
+    double speed;
+    int row;
+    int chunk_size;
+  } ctx{ cols, dp.data(), partial.data(), relax, uav_speed_, 0, 0 };
+  const std::function<void(int)> relax_chunk = [&ctx](int c) {
+    const int j_begin = c * ctx.chunk_size;
+    const int j_end = std::min(ctx.row, j_begin + ctx.chunk_size);
+    ctx.partial[c].result = (j_begin < j_end)
+      ? ctx.relax(ctx.cols, ctx.dp, ctx.row, j_begin, j_end, ctx.speed)
+      : RelaxResult{ std::numeric_limits<double>::max(), -1 };
+  };
+
+  for (int i = 1; i <= total_points; ++i) {
+    RelaxResult best;
+    if (executor && i >= parallel_threshold_) {
+      ctx.row = i;
+      ctx.chunk_size = ((i + chunks - 1) / chunks + 7) & ~7;  // multiple of 8 keeps chunks vector-aligned
+      executor->parallelFor(chunks, relax_chunk);
+      best = partial[0].result;
+      for (int c = 1; c < chunks; ++c) {
+        if (isBetterRelax(partial[c].result, best)) best = partial[c].result;
+      }
+    }
+    else {
+      best = relax(cols, dp.data(), i, 0, i, uav_speed_);
+    }
+    dp[i] = best.min_time + wait_time_;
+    prev_waypoint[i] = best.best_prev;
+    stats.candidates_evaluated += i;
+  }
+
+  reconstructPath(prev_waypoint, total_points, path, stats, profiling_);
+
+  return dp[total_points];
+}
+
+
+/**
+ * @brief Bounded-skip DP: no route may skip more than max_skip_ consecutive
+ *        waypoints
+ *
+ * Same recurrence and tie-break as solve(), restricted to predecessors
+ * j in [i - K - 1, i - 1] with K = max_skip_. Row i only reads the last K + 1
+ * DP values, so dp lives in a ring buffer of K + 1 slots and prev_waypoint is
+ * the only O(N) working array; a single pass streams through the columns.
+ *
+ * Time Complexity: O(N * K), working memory O(K) plus O(N) predecessor links
+ *
+ * @param cols  Columns of [start, wp1, wp2..., terminal] with penalty prefix sums
+ * @param path  Output vector storing indices of visited (optimal) waypoints in order
+ * @param stats Receives the number of candidate transitions evaluated
+ * @return double Minimal total time in seconds to complete the course
+ */
+double DeliveryUAV::solveWindow(
+  const WaypointColumns& cols,
+  std::vector<int>& path,
+  SolveStats& stats) const
+{
+  if (low_memory_) return solveWindowCheckpointed(cols, path, stats);
+
+  const int total_points = cols.count - 1;
+  const int window = std::min(max_skip_, total_points) + 1;  // predecessors per row
+  const EuclideanCost cost(uav_speed_);
+
+  // ring[j % window] holds dp[j] for the last `window` rows
+  SolveWorkspace& ws = workspace();
+  AlignedVector<double>& ring = ws.dp;
+  ring.assign(window, std::numeric_limits<double>::infinity());
+  ring[0] = 0.0;
+  std::vector<int>& prev_waypoint = ws.prev_waypoint;
+  prev_waypoint.assign(total_points + 1, -1);
+
+  double last = 0.0;
+  for (int i = 1; i <= total_points; ++i) {
+    const RelaxResult best = relaxWindowRow(cols, ring.data(), window, i, cost);
+
+    // Slot of i - window, which no later row reads
+    last = best.min_time + wait_time_;
+    ring[i % window] = last;
+    prev_waypoint[i] = best.best_prev;
+    stats.candidates_evaluated += i - std::max(0, i - window);
+  }
+
+  reconstructPath(prev_waypoint, total_points, path, stats, profiling_);
+
+  return last;
+}
+
+
+/**
+ * @brief Low-memory solveWindow(): periodic DP checkpoints instead of O(N)
+ *        predecessor links
+ *
+ * The forward pass keeps only the ring of the last K + 1 DP values and copies
+ * it every C rows (a checkpoint). During reconstruction the segment holding
+ * the current waypoint is recomputed from its checkpoint, with predecessor
+ * links for that segment only, and the path is followed back until it enters
+ * the previous segment. The recomputation repeats the forward arithmetic
+ * exactly, so time and path are identical to solveWindow().
+ *
+ * With C = sqrt(N * (K + 1)), memory drops from N ints to about
+ * 2 * sqrt(N * (K + 1)) values, for one extra forward pass of compute.
+ *
+ * @param cols  Columns of [start, wp1, wp2..., terminal] with penalty prefix sums
+ * @param path  Output vector storing indices of visited (optimal) waypoints in order
+ * @param stats Receives the number of candidate transitions evaluated, recomputation included
+ * @return double Minimal total time in seconds to complete the course
+ */
+double DeliveryUAV::solveWindowCheckpointed(
+  const WaypointColumns& cols,
+  std::vector<int>& path,
+  SolveStats& stats) const
+{
+  const int total_points = cols.count - 1;
+  const int window = std::min(max_skip_, total_points) + 1;
+  const EuclideanCost cost(uav_speed_);
+  const int interval = std::max(window,
+    (int)std::ceil(std::sqrt((double)total_points * window)));  // rows per segment
+  const int segments = (total_points + interval - 1) / interval;
+
+  SolveWorkspace& ws = workspace();
+  AlignedVector<double>& ring = ws.dp;
+  ring.assign(window, std::numeric_limits<double>::infinity());
+  ring[0] = 0.0;
+  // checkpoints[s] = ring before row 1 + s * interval
+  std::vector<double>& checkpoints = ws.checkpoints;
+  checkpoints.resize((size_t)segments * window);
+
+  double last = 0.0;
+  for (int i = 1; i <= total_points; ++i) {
+    if ((i - 1) % interval == 0) {
+      std::copy(ring.begin(), ring.end(), checkpoints.begin() + (size_t)((i - 1) / interval) * window);
+    }
+    const RelaxResult best = relaxWindowRow(cols, ring.data(), window, i, cost);
+    last = best.min_time + wait_time_;
+    ring[i % window] = last;
+    stats.candidates_evaluated += i - std::max(0, i - window);
+  }
+
+  PhaseTimer timer(phaseSink(stats, SolvePhase::Reconstruct, profiling_));
+  std::vector<int>& segment_prev = ws.prev_waypoint;
+  segment_prev.resize(interval);
+  // Segments are recomputed from the terminal backwards, so the visited
+  // points are collected last to first and then written to the path back
+  // to front (see reconstructPath)
+  std::vector<int>& hops = ws.hops;
+  hops.clear();
+  int current = total_points;
   while (current != 0) {
-    path.push_back(current);
-    current = prev_waypoint[current];
+    const int segment = (current - 1) / interval;
+    const int first_row = 1 + segment * interval;
+    std::copy(checkpoints.begin() + (size_t)segment * window,
+      checkpoints.begin() + (size_t)(segment + 1) * window, ring.begin());
+    for (int i = first_row; i <= current; ++i) {
+      const RelaxResult best = relaxWindowRow(cols, ring.data(), window, i, cost);
+      ring[i % window] = best.min_time + wait_time_;
+      segment_prev[i - first_row] = best.best_prev;
+      stats.candidates_evaluated += i - std::max(0, i - window);
+    }
+    while (current >= first_row) {
+      hops.push_back(current);
+      current = segment_prev[current - first_row];
+    }
   }
-  path.push_back(0); // Include start point
-  std::reverse(path.begin(), path.end());
+  path.resize(hops.size() + 1);
+  std::size_t pos = path.size();
+  for (const int point : hops) path[--pos] = point;
+  path[0] = 0;
 
-  // Final result is the minimal time to reach terminal point (last element)
-  return dp.back();
-}
\ No newline at end of file
+  return last;
+}
@@ -1,22 +1,311 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <fstream>
+#include <memory>
+
+/**
+ * SolverMode: selects the DP relaxation used by DeliveryUAV::solveCase.
+ * - Baseline: scans every predecessor j < i (reference implementation).
+ * - Pruned:   scans j downwards from i - 1 and stops once the skipped
+ *             penalties alone rule out every remaining predecessor.
+ * - Simd:     exhaustive scan over a structure-of-arrays copy of the
+ *             waypoints using the widest vector kernel the CPU supports.
+ * - Parallel: like Simd, but rows with many predecessors are split across
+ *             the threads of the UAV's persistent thread pool.
+ * - Window:   only predecessors that skip at most max_skip consecutive
+ *             waypoints (see DeliveryUAV::setMaxSkip), O(N * K) time.
+ * - Separable: O(N log N) for routes on one line and O(N log^2 N) for the
+ *             Manhattan cost model, where the transition cost splits into a
+ *             term of j and a term of i; Pruned for every other route.
+ * - Gpu:      exhaustive scan offloaded to the GPU backend (see gpu_backend.h)
+ *             with the same results as Simd; Simd if no backend is built in.
+ * - Spatial:  Pruned plus a bounding-box bound per block of consecutive
+ *             predecessors (see DeliveryUAV::setBlockSize), which rejects
+ *             whole blocks of far-away waypoints without evaluating them.
+ */
+enum class SolverMode {
+  Baseline,
+  Pruned,
+  Simd,
+  Parallel,
+  Window,
+  Separable,
+  Spatial,
+  Gpu
+};
+
+enum class SimdLevel;    // simd_kernels.h
+enum class OutputFormat; // result_writer.h
+struct WaypointColumns;  // waypoint_soa.h
+class ThreadPool;        // thread_pool.h
+class ParallelExecutor;  // parallel_executor.h
+struct SolveWorkspace;   // solve_workspace.h
+enum class Precision;    // precision_policy.h
+struct CostModel;        // cost_model.h
+class ResultCache;       // result_cache.h
+struct ResultCacheParams;
+template <typename Coord>
+struct ScaledColumns;    // precision_policy.h
+
+/**
+ * SolvePhase: labeled phases of DeliveryUAV::solveCase timed when profiling
+ * is enabled (see DeliveryUAV::setProfiling).
+ * - Load:        open/map the input, parse it and build the prefix sums.
+ * - OpenOutput:  create the output file.
+ * - Dp:          the DP relaxation of the selected solver.
+ * - Reconstruct: rebuild the visited waypoint sequence from the DP links.
+ * - Output:      format and write the result.
+ */
+enum class SolvePhase {
+  Load,
+  OpenOutput,
+  Dp,
+  Reconstruct,
+  Output,
+  Count
+};
+
+/**
+ * SolveStats: counters collected while solving a single case.
+ * - candidates_evaluated: number of (j, i) transitions whose time was computed.
+ * - bytes_read: size of the input file.
+ * - peak_rss_kb: peak resident memory of the process after the solve (profiling only).
+ * - phase_us / total_us: microseconds per SolvePhase and for the whole case
+ *   (profiling only, 0 otherwise).
+ * - peak_frontier: most predecessors held at once by the streaming solver.
+ * - blocks_skipped: predecessor blocks rejected by the spatial solver's bound.
+ * - proven_optimal / optimality_gap: outcome of a deadline-bounded solve
+ *   (see AnytimeResult); always optimal without a deadline.
+ * - cache_hit: the result came from the result cache, without parsing or DP.
+ * - cases: cases solved from a multi-case input (1 for a single case).
+ */
+struct SolveStats {
+  long long candidates_evaluated = 0;
+  long long bytes_read = 0;
+  long peak_rss_kb = 0;
+  long long phase_us[static_cast<int>(SolvePhase::Count)] = {};
+  long long total_us = 0;
+  long long peak_frontier = 0;
+  long long blocks_skipped = 0;
+  bool proven_optimal = true;
+  double optimality_gap = 0.0;
+  bool cache_hit = false;
+  long long cases = 1;
+};
 
 struct WayPoint {
   double x, y, penalty;
   WayPoint(double x_ = 0.0, double y_ = 0.0, double p_ = 0.0);
 };
 
+/**
+ * RouteInput: non-owning view of an in-memory route for DeliveryUAV::solveRoute.
+ * - start_*, terminal_*: coordinates of the start and terminal points.
+ * - x, y, penalty: the N waypoints, value k at x[k * stride] etc., so both
+ *   separate columns (stride 1) and WayPoint arrays (see fromWayPoints) work.
+ */
+struct RouteInput {
+  double start_x = 0.0, start_y = 0.0;
+  double terminal_x = 0.0, terminal_y = 0.0;
+  const double* x = nullptr;
+  const double* y = nullptr;
+  const double* penalty = nullptr;
+  std::size_t count = 0;
+  std::size_t stride = 1;  // in doubles
+
+  static RouteInput fromColumns(double start_x, double start_y, double terminal_x, double terminal_y,
+    const double* x, const double* y, const double* penalty, std::size_t count);
+  static RouteInput fromWayPoints(double start_x, double start_y, double terminal_x, double terminal_y,
+    const WayPoint* waypoints, std::size_t count);
+};
+
+/**
+ * RouteSegment: one leg of an optimal route, from point `from` to point `to`
+ * (0 = start, 1..N = waypoints, N + 1 = terminal).
+ * - flight_time: distance / speed.
+ * - skipped_penalty: penalties of the waypoints strictly between from and to.
+ * - wait_time: wait at `to`.
+ */
+struct RouteSegment {
+  int from, to;
+  double distance;
+  double flight_time;
+  double skipped_penalty;
+  double wait_time;
+};
+
+/**
+ * RouteResult: result of DeliveryUAV::solveRoute for a RouteInput. The
+ * vectors are caller-owned output buffers: reusing one RouteResult across
+ * solves keeps their capacity, so steady-state solves do not allocate.
+ * - total_time: minimum time from start to terminal.
+ * - path: visited points 0, ..., N + 1 in order (same indices as RouteSegment).
+ * - segments: one entry per leg of path, filled on request only.
+ */
+struct RouteResult {
+  double total_time = 0.0;
+  std::vector<int> path;
+  std::vector<RouteSegment> segments;
+};
+
+/**
+ * RouteAlternative: one of the K best routes of DeliveryUAV::solveTopRoutes,
+ * with its total time and visited points [0, ..., N + 1].
+ */
+struct RouteAlternative {
+  double total_time = 0.0;
+  std::vector<int> path;
+};
+
+/**
+ * AnytimeResult: best route found by DeliveryUAV::solveWithinDeadline.
+ * - optimal: true if the exact DP finished, i.e. total_time is the minimum.
+ * - lower_bound: proven lower bound of the minimal time.
+ * - gap: (total_time - lower_bound) / total_time, 0 when optimal.
+ * - exact_rows: waypoints whose exact DP value was computed before the deadline.
+ */
+struct AnytimeResult {
+  double total_time = 0.0;
+  std::vector<int> path;
+  bool optimal = false;
+  double lower_bound = 0.0;
+  double gap = 0.0;
+  int exact_rows = 0;
+};
+
+/**
+ * FleetObjective: what DeliveryUAV::solveFleet minimizes.
+ * - TotalTime: sum of the drone times (total flying time of the fleet).
+ * - Makespan:  time of the slowest drone (all drones take off together).
+ */
+enum class FleetObjective {
+  TotalTime,
+  Makespan
+};
+
+/**
+ * DroneRoute: one drone of a fleet solve, covering waypoints first..last,
+ * with its total time and visited points [0, ..., N + 1] (route indices).
+ */
+struct DroneRoute {
+  int first = 1, last = 0;
+  double total_time = 0.0;
+  std::vector<int> path;
+};
+
+/**
+ * FleetResult: result of DeliveryUAV::solveFleet.
+ * - drones: one route per drone, in waypoint order.
+ * - total_time / makespan: sum and maximum of the drone times.
+ * - objective: the minimized value (total_time or makespan).
+ */
+struct FleetResult {
+  std::vector<DroneRoute> drones;
+  double total_time = 0.0;
+  double makespan = 0.0;
+  double objective = 0.0;
+};
+
 class DeliveryUAV {
 public:
-  DeliveryUAV(double speed, double wait_time);
-  int solveCase(const std::string& input_file_name, const std::string& output_file_name);
+  // Largest k of solveTopRoutes(); the labels take (N + 2) * k entries
+  static constexpr int kMaxTopRoutes = 1000;
+
+  DeliveryUAV(double speed, double wait_time, int threads = 1);
+  ~DeliveryUAV();
+  DeliveryUAV(DeliveryUAV&&) noexcept;
+  DeliveryUAV& operator=(DeliveryUAV&&) noexcept;
+
+  int solveCase(const std::string& input_file_name, const std::string& output_file_name, SolveStats* stats = nullptr) const;
+  double solveRoute(const WaypointColumns& cols, std::vector<int>& path, SolveStats* stats = nullptr) const;
+  void solveRoute(const RouteInput& route, RouteResult& result, bool with_segments = false, SolveStats* stats = nullptr) const;
+  void solveTopRoutes(const WaypointColumns& cols, int k, std::vector<RouteAlternative>& routes, SolveStats* stats = nullptr) const;
+  void solveWithinDeadline(const WaypointColumns& cols, double budget_ms, AnytimeResult& result, SolveStats* stats = nullptr) const;
+  void solveFleet(const WaypointColumns& cols, int drones, FleetObjective objective, FleetResult& result,
+    SolveStats* stats = nullptr) const;
+  void setSolverMode(SolverMode mode);
+  SolverMode solverMode() const { return solver_mode_; }
+  double speed() const { return uav_speed_; }
+  double waitTime() const { return wait_time_; }
+  void setSimdLevel(SimdLevel level);
+  SimdLevel simdLevel() const;
+  void setPrecision(Precision precision);
+  void setCostModel(std::shared_ptr<const CostModel> model);
+  const CostModel* costModel() const { return cost_model_.get(); }
+  Precision precision() const { return precision_; }
+  void setParallelThreshold(int min_predecessors);
+  int threads() const;
+  void setExecutor(ParallelExecutor* executor);
+  void setOutputFormat(OutputFormat format);
+  void setProfiling(bool enabled, bool write_sidecar = false);
+  void setMaxSkip(int max_skip);
+  void setBlockSize(int block_size);
+  void setTileSize(int tile_size);
+  void setStreaming(bool enabled);
+  void setMultiCase(bool enabled);
+  void setLowMemory(bool enabled);
+  void setWorkspace(SolveWorkspace* workspace);
+  void setTopRoutes(int k);
+  void setDeadline(double budget_ms);
+  void setFleet(int drones, FleetObjective objective);
+  void setResultCache(std::shared_ptr<ResultCache> cache);
+  ResultCache* resultCache() const { return result_cache_.get(); }
+  ResultCacheParams cacheParams() const;
 
 private:
   double uav_speed_;
   double wait_time_;
-  double solve(const std::vector<WayPoint>& waypoints, const std::vector<double>& prefix, std::vector<int>& path);
+  SolverMode solver_mode_ = SolverMode::Baseline;
+  SimdLevel simd_level_;
+  Precision precision_;
+  std::shared_ptr<const CostModel> cost_model_;  // nullptr: Euclidean
+  std::uint64_t cost_model_hash_ = 0;  // content hash of cost_model_ for the result cache
+  OutputFormat output_format_;
+  std::unique_ptr<ThreadPool> pool_;
+  ParallelExecutor* executor_ = nullptr;  // pool_ or an external executor
+  int parallel_threshold_;
+  bool profiling_ = false;
+  int max_skip_ = 0;
+  int block_size_ = 8;
+  int tile_size_ = 0;
+  bool streaming_ = false;
+  bool multi_case_ = false;
+  bool low_memory_ = false;
+  int top_routes_ = 1;
+  double deadline_ms_ = 0.0;  // 0: no deadline
+  int fleet_drones_ = 1;
+  FleetObjective fleet_objective_ = FleetObjective::TotalTime;
+  std::shared_ptr<ResultCache> result_cache_;  // nullptr: no caching
+  SolveWorkspace* workspace_ = nullptr;  // nullptr: one workspace per thread
+  SolveWorkspace& workspace() const;
+  bool stats_sidecar_ = false;
+  template <typename Cost>
+  double solve(const std::vector<WayPoint>& waypoints, const std::vector<double>& prefix, const Cost& cost,
+    std::vector<int>& path, SolveStats& stats) const;
+  template <typename Cost>
+  double solvePruned(const WaypointColumns& cols, const Cost& cost, std::vector<int>& path, SolveStats& stats) const;
+  double solveSimd(const WaypointColumns& cols, std::vector<int>& path, SolveStats& stats) const;
+  double solveGpu(const WaypointColumns& cols, std::vector<int>& path, SolveStats& stats) const;
+  template <typename Policy>
+  double solveScaled(const WaypointColumns& cols, ScaledColumns<typename Policy::Coord>& coords,
+    std::vector<int>& path, SolveStats& stats) const;
+  double solveParallel(const WaypointColumns& cols, std::vector<int>& path, SolveStats& stats) const;
+  double solveWindow(const WaypointColumns& cols, std::vector<int>& path, SolveStats& stats) const;
+  double solveWindowCheckpointed(const WaypointColumns& cols, std::vector<int>& path, SolveStats& stats) const;
+  template <typename Cost>
+  void solveTopK(const WaypointColumns& cols, const Cost& cost, int k, std::vector<RouteAlternative>& routes, SolveStats& stats) const;
+  template <typename Cost>
+  void solveFleetSegments(const WaypointColumns& cols, const Cost& cost, int drones, FleetObjective objective,
+    FleetResult& result, SolveStats& stats) const;
+  template <typename Cost>
+  double solveSpatial(const WaypointColumns& cols, const Cost& cost, std::vector<int>& path, SolveStats& stats) const;
+  double solveSpatialBlocks(const WaypointColumns& cols, std::vector<int>& path, SolveStats& stats) const;
+  bool solveSeparable(const WaypointColumns& cols, std::vector<int>& path, SolveStats& stats, double& result) const;
+  int solveStreamCase(const std::string& input_file_name, const std::string& output_file_name, SolveStats* stats) const;
+  int solveMultiCase(const std::string& input_file_name, const std::string& output_file_name, SolveStats* stats) const;
 
 };
\ No newline at end of file
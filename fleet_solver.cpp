@@ -0,0 +1,279 @@
+#include "delivery_uav.h"
+#include "cost_model.h"
+#include "parallel_executor.h"
+#include "solve_workspace.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+/**
+ * @brief Best predecessor slot of point i among slots [0, slots) of a
+ *        segment: the backward scan of solvePruned(), with the start last
+ *
+ * penalties_before_i is the prefix of the last waypoint that point i skips
+ * (prefix[i - 1], or the segment's last waypoint for the terminal).
+ *
+ * The bound floor[s] leaves out the start: its key -prefix[a - 1] would stop
+ * no scan once the segment is far from the start. The start is evaluated
+ * separately, after every other slot, which keeps its smallest-index
+ * tie-break, so the values and links are those of solvePruned().
+ */
+template <typename Cost>
+RelaxResult relaxSlots(const WaypointColumns& cols, const Cost& cost, int a, const FleetScratch& scratch,
+  int slots, int i, double penalties_before_i, long long& candidates)
+{
+  RelaxResult best{ std::numeric_limits<double>::max(), -1 };
+  auto consider = [&](int s) {
+    const int j = s ? a - 1 + s : 0;
+    const double time_candidate = scratch.dp[s] +
+      cost.travelTime(cols.x[j], cols.y[j], cols.x[i], cols.y[i], j, i, scratch.dp[s]) +
+      (penalties_before_i - cols.prefix[a - 1 + s]);
+    ++candidates;
+    // '<=' while scanning downwards keeps the smallest slot among equal times
+    if (time_candidate <= best.min_time) {
+      best.min_time = time_candidate;
+      best.best_prev = s;
+    }
+  };
+  for (int s = slots - 1; s >= 1; --s) {
+    if (scratch.floor[s] + penalties_before_i - best.min_time > 1e-12 * std::fabs(best.min_time)) break;
+    consider(s);
+  }
+  consider(0);
+  return best;
+}
+
+/**
+ * @brief Pruned DP of the sub-route [start, wp a..last] of a segment
+ *
+ * Local slot t = 0 is the start point and slot t >= 1 waypoint a - 1 + t, so
+ * prefix[a - 1 + t] is the prefix of every slot (the start's value
+ * prefix[a - 1] makes the penalties of skipped waypoints count from a). Travel
+ * times use the global point indices, so the distance matrix model works
+ * unchanged. With a = 1 the rows are those of solvePruned().
+ *
+ * @return long long Candidates evaluated
+ */
+template <typename Cost>
+long long segmentRows(const WaypointColumns& cols, const Cost& cost, double wait_time, int a, int last,
+  FleetScratch& scratch)
+{
+  const int slots = last - a + 2;
+  scratch.dp.resize(slots);
+  scratch.floor.resize(slots);
+  scratch.prev.resize(slots + 1);  // + terminal, see relaxTerminal()
+  scratch.dp[0] = 0.0;
+  scratch.floor[0] = std::numeric_limits<double>::infinity();  // start excluded, see relaxSlots()
+  scratch.prev[0] = -1;
+
+  long long candidates = 0;
+  for (int t = 1; t < slots; ++t) {
+    const int i = a - 1 + t;
+    const RelaxResult best = relaxSlots(cols, cost, a, scratch, t, i, cols.prefix[i - 1], candidates);
+    scratch.dp[t] = best.min_time + wait_time;
+    scratch.prev[t] = best.best_prev;
+    scratch.floor[t] = std::min(scratch.floor[t - 1], scratch.dp[t] - cols.prefix[a - 1 + t]);
+  }
+  return candidates;
+}
+
+/**
+ * @brief Exact time of the drone covering waypoints a..last: the terminal row
+ *        of segmentRows(), with its link stored at slot last - a + 2
+ */
+template <typename Cost>
+double relaxTerminal(const WaypointColumns& cols, const Cost& cost, double wait_time, int a, int last,
+  FleetScratch& scratch, long long& candidates)
+{
+  const int slots = last - a + 2;
+  const RelaxResult best = relaxSlots(cols, cost, a, scratch, slots, cols.count - 1, cols.prefix[last], candidates);
+  scratch.prev[slots] = best.best_prev;
+  return best.min_time + wait_time;
+}
+
+inline double combine(FleetObjective objective, double before, double segment)
+{
+  return objective == FleetObjective::Makespan ? std::max(before, segment) : before + segment;
+}
+
+} // namespace
+
+
+/**
+ * @brief Optimal split of one waypoint sequence into contiguous segments,
+ *        one per drone (see solveFleet())
+ *
+ * cost(a, b) is the time of a drone that takes off at the start, covers
+ * waypoints a..b (visiting or skipping each as in solve()) and lands at the
+ * terminal. One pruned DP from each segment start a yields cost(a, b) for
+ * every b at once: cost(a, b) = min_s (dp_a[s] - prefix[s] + |s, T|) +
+ * prefix[b] + wait. The layered DP over split points is
+ *   F[m][b] = min_a combine(F[m - 1][a - 1], cost(a, b))
+ * with combine = + (total time) or max (makespan). Rows a are computed in
+ * blocks, in parallel on the UAV's executor, and folded into F in ascending
+ * order, since F[m - 1][a - 1] is final once every row below a is folded; ties
+ * keep the smallest a. Only M + 1 layers and one block of rows are held.
+ * The drones of the chosen split are finally solved exactly (their own
+ * terminal row with predecessor links), so the reported times and paths are
+ * those of a pruned solve of each sub-route, and one drone gives the pruned
+ * result of the whole route.
+ *
+ * Time Complexity: O(N^2) candidate scans (pruned) + O(M * N^2) layer updates
+ */
+template <typename Cost>
+void DeliveryUAV::solveFleetSegments(
+  const WaypointColumns& cols,
+  const Cost& cost,
+  int drones,
+  FleetObjective objective,
+  FleetResult& result,
+  SolveStats& stats) const
+{
+  const int waypoints = cols.count - 2;
+  const double inf = std::numeric_limits<double>::infinity();
+  SolveWorkspace& ws = workspace();
+  const int block = drones > 1 ? std::max(1, threads()) * 4 : 0;
+  ws.fleet_scratch.resize(std::max(block, drones));
+  std::vector<long long> candidates(ws.fleet_scratch.size(), 0);
+
+  auto runTasks = [&](int tasks, const std::function<void(int)>& task) {
+    if (executor_ && tasks > 1) executor_->parallelFor(tasks, task);
+    else for (int t = 0; t < tasks; ++t) task(t);
+  };
+
+  // first waypoint of every drone, in order; drone d covers first[d]..first[d + 1] - 1
+  std::vector<int> first(drones + 1);
+  first[0] = 1;
+  first[drones] = waypoints + 1;
+  if (drones > 1) {
+    const int width = waypoints + 1;  // b = 0..N
+    std::vector<double>& value = ws.fleet_value;
+    std::vector<int>& split = ws.fleet_split;
+    value.assign((size_t)(drones + 1) * width, inf);
+    split.assign((size_t)(drones + 1) * width, -1);
+    value[0] = 0.0;
+    std::vector<double>& rows = ws.fleet_rows;
+    rows.resize((size_t)block * width);
+
+    for (int a0 = 1; a0 <= waypoints; a0 += block) {
+      const int count = std::min(block, waypoints - a0 + 1);
+      runTasks(count, [&](int r) {
+        const int a = a0 + r;
+        FleetScratch& scratch = ws.fleet_scratch[r];
+        candidates[r] += segmentRows(cols, cost, wait_time_, a, waypoints, scratch);
+        // Running minimum of leaving the segment from slot s for the terminal
+        const int terminal = waypoints + 1;
+        double* cost_row = rows.data() + (size_t)r * width;
+        double leave = inf;
+        for (int s = 0; s <= waypoints - a + 1; ++s) {
+          const int j = s ? a - 1 + s : 0;
+          leave = std::min(leave, scratch.dp[s] - cols.prefix[a - 1 + s] +
+            cost.travelTime(cols.x[j], cols.y[j], cols.x[terminal], cols.y[terminal], j, terminal, scratch.dp[s]));
+          if (s) cost_row[a - 1 + s] = leave + cols.prefix[a - 1 + s] + wait_time_;
+        }
+      });
+      for (int r = 0; r < count; ++r) {
+        const int a = a0 + r;
+        const double* cost_row = rows.data() + (size_t)r * width;
+        for (int m = 1; m <= std::min(drones, a); ++m) {
+          const double before = value[(size_t)(m - 1) * width + (a - 1)];
+          if (before == inf) continue;
+          double* layer = value.data() + (size_t)m * width;
+          int* layer_split = split.data() + (size_t)m * width;
+          // The remaining drones - m drones need at least one waypoint each
+          for (int b = a; b <= waypoints - (drones - m); ++b) {
+            const double candidate = combine(objective, before, cost_row[b]);
+            if (candidate < layer[b]) {
+              layer[b] = candidate;
+              layer_split[b] = a;
+            }
+          }
+        }
+      }
+    }
+    for (int m = drones, b = waypoints; m > 0; --m) {
+      first[m - 1] = split[(size_t)m * width + b];
+      b = first[m - 1] - 1;
+    }
+  }
+
+  // Exact route of every drone of the split
+  result.drones.resize(drones);
+  runTasks(drones, [&](int d) {
+    const int a = first[d], last = first[d + 1] - 1;
+    FleetScratch& scratch = ws.fleet_scratch[d];
+    long long count = segmentRows(cols, cost, wait_time_, a, last, scratch);
+    DroneRoute& route = result.drones[d];
+    route.first = a;
+    route.last = last;
+    route.total_time = relaxTerminal(cols, cost, wait_time_, a, last, scratch, count);
+    candidates[d] += count;
+
+    // Slot links back from the terminal slot, converted to global indices
+    const int terminal_slot = last - a + 2;
+    int length = 0;
+    for (int s = terminal_slot; s >= 0; s = scratch.prev[s]) ++length;
+    route.path.resize(length);
+    for (int s = terminal_slot, k = length - 1; s >= 0; s = scratch.prev[s], --k) {
+      route.path[k] = s == terminal_slot ? cols.count - 1 : (s ? a - 1 + s : 0);
+    }
+  });
+
+  result.total_time = 0.0;
+  result.makespan = 0.0;
+  for (const DroneRoute& route : result.drones) {
+    result.total_time += route.total_time;
+    result.makespan = std::max(result.makespan, route.total_time);
+  }
+  result.objective = objective == FleetObjective::Makespan ? result.makespan : result.total_time;
+  for (const long long count : candidates) stats.candidates_evaluated += count;
+}
+
+
+/**
+ * @brief Splits the waypoint sequence into `drones` contiguous, non-empty
+ *        segments, one per UAV, that minimize the total or the maximum time
+ *
+ * Every drone has this UAV's speed, wait time and cost model, takes off at
+ * the start, covers its segment like a single-UAV route (skipping waypoints
+ * for their penalty) and lands at the terminal. Segment costs are computed
+ * in parallel on the UAV's thread pool (see DeliveryUAV(speed, wait, threads)).
+ * With one drone the result is the pruned solve of the whole route.
+ *
+ * @param cols      Columns of [start, wp1, wp2..., terminal] with penalty prefix sums
+ * @param drones    Number of drones, 1 <= drones <= max(1, N)
+ * @param objective FleetObjective::TotalTime or FleetObjective::Makespan
+ * @param result    Receives one DroneRoute per drone and the fleet totals
+ * @param stats     Optional sink for solver counters
+ *
+ * @throws std::invalid_argument for an invalid number of drones or a
+ *         distance matrix of another size
+ */
+void DeliveryUAV::solveFleet(
+  const WaypointColumns& cols,
+  int drones,
+  FleetObjective objective,
+  FleetResult& result,
+  SolveStats* stats) const
+{
+  const int waypoints = cols.count - 2;
+  if (drones < 1 || drones > std::max(1, waypoints)) {
+    throw std::invalid_argument("cannot split " + std::to_string(waypoints) + " waypoints across " +
+      std::to_string(drones) + " drones");
+  }
+  const CostModel* cost_model = cost_model_.get();
+  if (cost_model && cost_model->kind == CostModelKind::DistanceMatrix && cost_model->matrix_size != cols.count) {
+    throw std::invalid_argument("distance matrix has " + std::to_string(cost_model->matrix_size) +
+      " points, the route has " + std::to_string(cols.count));
+  }
+  SolveStats route_stats;
+  dispatchCostModel(cost_model, uav_speed_, [&](const auto& cost) {
+    solveFleetSegments(cols, cost, drones, objective, result, route_stats);
+  });
+  if (stats) *stats = route_stats;
+}
@@ -0,0 +1,204 @@
+#include "gpu_backend.h"
+#include <cuda_runtime.h>
+#include <algorithm>
+#include <cfloat>
+
+namespace {
+
+constexpr int kThreads = 256;                 // threads per block
+constexpr int kChunk = kThreads * 16;         // predecessors per rectangle block
+
+/**
+ * DeviceRelax: partial min/argmin, merged with the rule of isBetterRelax
+ * (lower time, then smaller predecessor) so that any reduction order selects
+ * the same predecessor as the ascending CPU scan.
+ */
+struct DeviceRelax {
+  double time;
+  int prev;
+};
+
+__device__ inline bool better(const DeviceRelax& b, const DeviceRelax& a)
+{
+  if (b.prev < 0) return false;
+  if (a.prev < 0) return true;
+  return b.time < a.time || (b.time == a.time && b.prev < a.prev);
+}
+
+/**
+ * @brief Candidate time of predecessor j for row i, rounded operation by
+ *        operation like relaxScalar (no fused multiply-add), so the device
+ *        returns the same times as the CPU kernels.
+ */
+__device__ inline double candidate(const double* x, const double* y, const double* prefix, const double* dp,
+  double xi, double yi, double penalties_before_i, double speed, int j)
+{
+  const double dx = __dsub_rn(xi, x[j]);
+  const double dy = __dsub_rn(yi, y[j]);
+  const double distance = __dsqrt_rn(__dadd_rn(__dmul_rn(dx, dx), __dmul_rn(dy, dy)));
+  return __dadd_rn(__dadd_rn(dp[j], __ddiv_rn(distance, speed)), __dsub_rn(penalties_before_i, prefix[j]));
+}
+
+/**
+ * @brief Block-wide reduction of one DeviceRelax per thread; the result is
+ *        valid in thread 0
+ */
+__device__ DeviceRelax reduceBlock(DeviceRelax value)
+{
+  __shared__ double times[kThreads];
+  __shared__ int prevs[kThreads];
+  const int t = threadIdx.x;
+  times[t] = value.time;
+  prevs[t] = value.prev;
+  __syncthreads();
+  for (int stride = kThreads / 2; stride > 0; stride /= 2) {
+    if (t < stride) {
+      const DeviceRelax other{ times[t + stride], prevs[t + stride] };
+      const DeviceRelax mine{ times[t], prevs[t] };
+      if (better(other, mine)) {
+        times[t] = other.time;
+        prevs[t] = other.prev;
+      }
+    }
+    __syncthreads();
+  }
+  const DeviceRelax result{ times[0], prevs[0] };
+  __syncthreads();  // the buffers are reused by the next call
+  return result;
+}
+
+/**
+ * @brief Rectangle of a tile: rows [i0, i0 + rows) against the final
+ *        predecessors [0, i0), one chunk of kChunk predecessors per block
+ *        (blockIdx.x) and row (blockIdx.y)
+ */
+__global__ void relaxRectangle(const double* x, const double* y, const double* prefix, const double* dp,
+  int i0, double speed, int chunks, DeviceRelax* partial)
+{
+  const int i = i0 + blockIdx.y;
+  const int j_begin = blockIdx.x * kChunk;
+  const int j_end = min(i0, j_begin + kChunk);
+  const double xi = x[i], yi = y[i], penalties_before_i = prefix[i - 1];
+
+  DeviceRelax best{ DBL_MAX, -1 };
+  for (int j = j_begin + threadIdx.x; j < j_end; j += kThreads) {
+    const double time = candidate(x, y, prefix, dp, xi, yi, penalties_before_i, speed, j);
+    if (time < best.time) best = DeviceRelax{ time, j };  // ascending j per thread
+  }
+  best = reduceBlock(best);
+  if (threadIdx.x == 0) partial[blockIdx.y * chunks + blockIdx.x] = best;
+}
+
+/**
+ * @brief Finishes rows [i0, i1) in order in one block: merges the row's
+ *        rectangle partials with the triangle [i0, i) and stores dp[i] and
+ *        prev[i] before the next row reads them
+ */
+__global__ void finishTile(const double* x, const double* y, const double* prefix, double* dp, int* prev,
+  int i0, int i1, double speed, double wait_time, int chunks, const DeviceRelax* partial)
+{
+  for (int i = i0; i < i1; ++i) {
+    const double xi = x[i], yi = y[i], penalties_before_i = prefix[i - 1];
+    DeviceRelax best{ DBL_MAX, -1 };
+    for (int c = threadIdx.x; c < chunks; c += kThreads) {
+      const DeviceRelax part = partial[(i - i0) * chunks + c];
+      if (better(part, best)) best = part;
+    }
+    for (int j = i0 + threadIdx.x; j < i; j += kThreads) {
+      const DeviceRelax part{ candidate(x, y, prefix, dp, xi, yi, penalties_before_i, speed, j), j };
+      if (better(part, best)) best = part;
+    }
+    best = reduceBlock(best);
+    if (threadIdx.x == 0) {
+      dp[i] = __dadd_rn(best.time, wait_time);
+      prev[i] = best.prev;
+    }
+    __syncthreads();  // dp[i] is a predecessor of row i + 1
+  }
+}
+
+/**
+ * DeviceBuffer: owning device allocation, released on scope exit.
+ */
+template <typename T>
+struct DeviceBuffer {
+  T* data = nullptr;
+  cudaError_t allocate(size_t count) { return cudaMalloc(&data, count * sizeof(T)); }
+  ~DeviceBuffer() { if (data) cudaFree(data); }
+};
+
+bool failed(cudaError_t status, std::string& error)
+{
+  if (status == cudaSuccess) return false;
+  error = cudaGetErrorString(status);
+  return true;
+}
+
+} // namespace
+
+
+bool gpuBackendAvailable(std::string& description)
+{
+  int devices = 0;
+  if (cudaGetDeviceCount(&devices) != cudaSuccess || devices == 0) {
+    description = "no CUDA device found";
+    return false;
+  }
+  cudaDeviceProp properties;
+  if (cudaGetDeviceProperties(&properties, 0) != cudaSuccess) {
+    description = "cannot query CUDA device 0";
+    return false;
+  }
+  description = properties.name;
+  return true;
+}
+
+/**
+ * @brief Wavefront tiles of the exhaustive DP on the device
+ *
+ * Row tiles [i0, i1) are aligned to multiples of `tile` as in relaxTiled():
+ * relaxRectangle evaluates all rows of the tile against the final
+ * predecessors below i0 in parallel (tile x i0 / kChunk blocks), then
+ * finishTile completes the rows in order in a single block. Two launches
+ * per tile, and dp never leaves the device.
+ */
+bool gpuSolveRoute(const double* x, const double* y, const double* prefix, int count,
+  double speed, double wait_time, int tile, int* prev_waypoint, double& total_time, std::string& error)
+{
+  const int total_points = count - 1;
+  tile = std::max(1, std::min(tile, 65535));  // rows of a tile are gridDim.y
+  const int max_chunks = (count + kChunk - 1) / kChunk;
+  DeviceBuffer<double> d_x, d_y, d_prefix, d_dp;
+  DeviceBuffer<int> d_prev;
+  DeviceBuffer<DeviceRelax> d_partial;
+  if (failed(d_x.allocate(count), error) || failed(d_y.allocate(count), error) ||
+    failed(d_prefix.allocate(count), error) || failed(d_dp.allocate(count), error) ||
+    failed(d_prev.allocate(count), error) || failed(d_partial.allocate((size_t)tile * max_chunks), error)) {
+    return false;
+  }
+  const double zero = 0.0;
+  const int none = -1;
+  if (failed(cudaMemcpy(d_x.data, x, count * sizeof(double), cudaMemcpyHostToDevice), error) ||
+    failed(cudaMemcpy(d_y.data, y, count * sizeof(double), cudaMemcpyHostToDevice), error) ||
+    failed(cudaMemcpy(d_prefix.data, prefix, count * sizeof(double), cudaMemcpyHostToDevice), error) ||
+    failed(cudaMemcpy(d_dp.data, &zero, sizeof(double), cudaMemcpyHostToDevice), error) ||
+    failed(cudaMemcpy(d_prev.data, &none, sizeof(int), cudaMemcpyHostToDevice), error)) {
+    return false;
+  }
+
+  for (int i0 = 1, i1; i0 <= total_points; i0 = i1) {
+    i1 = std::min(total_points + 1, (i0 / tile + 1) * tile);
+    const int chunks = (i0 + kChunk - 1) / kChunk;
+    relaxRectangle<<<dim3(chunks, i1 - i0), kThreads>>>(d_x.data, d_y.data, d_prefix.data, d_dp.data,
+      i0, speed, chunks, d_partial.data);
+    finishTile<<<1, kThreads>>>(d_x.data, d_y.data, d_prefix.data, d_dp.data, d_prev.data,
+      i0, i1, speed, wait_time, chunks, d_partial.data);
+    if (failed(cudaGetLastError(), error)) return false;
+  }
+
+  if (failed(cudaMemcpy(prev_waypoint, d_prev.data, count * sizeof(int), cudaMemcpyDeviceToHost), error) ||
+    failed(cudaMemcpy(&total_time, d_dp.data + total_points, sizeof(double), cudaMemcpyDeviceToHost), error)) {
+    return false;
+  }
+  return true;
+}
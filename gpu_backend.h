@@ -0,0 +1,36 @@
+#pragma once
+
+#include <string>
+
+/**
+ * GPU offload of the exhaustive DP (SolverMode::Gpu).
+ *
+ * Built from gpu_backend.cu when a CUDA toolkit is found (DUAV_HAVE_CUDA);
+ * without it the stubs in gpu_solver.cpp report the backend as unavailable
+ * and DeliveryUAV falls back to the simd solver.
+ */
+
+/**
+ * @brief True if the binary was built with the GPU backend and a device is
+ *        usable; `description` receives the device name or the reason why not
+ */
+bool gpuBackendAvailable(std::string& description);
+
+/**
+ * @brief Runs the exhaustive DP on the device
+ *
+ * The columns of [start, wp1..wpN, terminal] are copied to the device once
+ * and stay resident together with dp; only the predecessor links and the
+ * final time come back.
+ *
+ * @param x, y, prefix  Columns of the route (count points)
+ * @param speed         UAV cruising speed
+ * @param wait_time     Wait time at every visited point
+ * @param tile          Rows per wavefront tile (>= 1)
+ * @param prev_waypoint Receives count predecessor links (prev_waypoint[0] = -1)
+ * @param total_time    Receives the minimal total time
+ * @param error         Receives the CUDA error on failure
+ * @return bool true on success
+ */
+bool gpuSolveRoute(const double* x, const double* y, const double* prefix, int count,
+  double speed, double wait_time, int tile, int* prev_waypoint, double& total_time, std::string& error);
@@ -0,0 +1,66 @@
+#include "delivery_uav.h"
+#include "gpu_backend.h"
+#include "path_utils.h"
+#include "solve_profile.h"
+#include "solve_workspace.h"
+#include <iostream>
+
+// Rows per wavefront tile when no --tile-size is given
+constexpr int kDefaultGpuTile = 256;
+
+#if !defined(DUAV_HAVE_CUDA)
+bool gpuBackendAvailable(std::string& description)
+{
+  description = "built without CUDA support";
+  return false;
+}
+
+bool gpuSolveRoute(const double*, const double*, const double*, int, double, double, int, int*, double&,
+  std::string& error)
+{
+  error = "built without CUDA support";
+  return false;
+}
+#endif
+
+
+/**
+ * @brief Exhaustive DP on the GPU backend (SolverMode::Gpu)
+ *
+ * The device evaluates the same candidate expression as the CPU kernels,
+ * without fused multiply-adds, and merges partial minima with the
+ * smallest-index tie-break, so time and path match solveSimd(). The route
+ * runs in wavefront tiles of setTileSize() rows (256 by default), see
+ * gpuSolveRoute(). Without a usable backend, or if the device fails
+ * (reported on cerr), the route is solved by solveSimd() instead.
+ *
+ * @param cols  Columns of [start, wp1, wp2..., terminal] with penalty prefix sums
+ * @param path  Output vector storing indices of visited (optimal) waypoints in order
+ * @param stats Receives the number of candidate transitions evaluated
+ * @return double Minimal total time in seconds to complete the course
+ */
+double DeliveryUAV::solveGpu(
+  const WaypointColumns& cols,
+  std::vector<int>& path,
+  SolveStats& stats) const
+{
+  std::string description;
+  if (!gpuBackendAvailable(description)) return solveSimd(cols, path, stats);
+
+  const int total_points = cols.count - 1;
+  SolveWorkspace& ws = workspace();
+  std::vector<int>& prev_waypoint = ws.prev_waypoint;
+  prev_waypoint.assign(total_points + 1, -1);
+  double total_time = 0.0;
+  std::string error;
+  if (!gpuSolveRoute(cols.x, cols.y, cols.prefix, cols.count, uav_speed_, wait_time_,
+    tile_size_ > 0 ? tile_size_ : kDefaultGpuTile, prev_waypoint.data(), total_time, error)) {
+    std::cerr << "GPU solve failed (" << error << "), using the simd solver\n";
+    return solveSimd(cols, path, stats);
+  }
+  stats.candidates_evaluated += (long long)total_points * (total_points + 1) / 2;
+
+  PhaseTimer timer(phaseSink(stats, SolvePhase::Reconstruct, profiling_));
+  reconstructPath(prev_waypoint, total_points, path);
+  return total_time;
+}
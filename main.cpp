@@ -1,6 +1,28 @@
+#include "batch_runner.h"
+#include "binary_route.h"
+#include "cost_model.h"
+#include "gpu_backend.h"
+#include "parameter_sweep.h"
+#include "precision_policy.h"
 #include "delivery_uav.h"
+#include "result_cache.h"
+#include "result_writer.h"
+#include "route_file.h"
+#include "simd_kernels.h"
+#include "solve_profile.h"
+#include "solver_service.h"
+#include "solve_verify.h"
+#include <charconv>
 #include <string>
+#include <thread>
 #include <iostream>
+#include <stdexcept>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <memory>
+#include <type_traits>
 
 /**
  * Config: Structure to hold configurable parameters for the program.
@@ -8,29 +30,444 @@
  * - output_path: Path the output data file.
  * - uavSpeed: Speed of the UAV (default: 2.0 m/s).
  * - waitTime: Wait time at each waypoint (default: 10 s).
+ * - solver_mode: DP relaxation to use (default: baseline).
+ * - simd_level: Highest vector kernel for the simd solver (default: auto).
+ * - precision: Coordinate precision of the simd solver (default: double).
+ * - verify_precision: Report the divergence of --precision from the double reference.
+ * - verify: Check the solver's result against the baseline DP (single case,
+ *   or every verify_every-th case of a batch) within verify_tolerance.
+ * - cost_model: Travel time model of the baseline and pruned solvers (default: Euclidean).
+ * - top_k: Number of distinct routes reported per case (default: 1).
+ * - drones / fleet_objective: Split each route across this many drones,
+ *   minimizing the total time or the makespan (default: 1 drone).
+ * - threads: Threads used by the parallel solver (default: 1, 0 = all cores).
+ * - max_skip: Longest run of skipped waypoints for the window solver.
+ * - block_size: Predecessors per bounding box of the spatial solver (default: 8).
+ * - tile_size: Rows and predecessors per cache tile of the simd solver (0 = untiled),
+ *   or rows per wavefront tile of the gpu solver (0 = 256).
+ * - stream: Parse and solve concurrently, keeping only the live frontier.
+ * - multi_case: The input holds several concatenated cases, solved in a
+ *   parse / solve / write pipeline into one output file.
+ * - low_memory: Checkpointed path reconstruction for the window solver.
+ * - batch_source: Directory or manifest of cases; enables batch mode.
+ * - batch_output_dir: Output directory for a directory batch source.
+ * - convert: Convert the text input into a binary route instead of solving.
+ * - float32: Store x, y and penalty as float32 when converting.
+ * - output_format: Layout of the solution files (default: text).
+ * - sweep: (speed, wait time) pairs solved together from one load of the input.
+ * - profile: Print phase timings and counters of the solved case.
+ * - stats_json: Write the statistics of each case to <output_path>.stats.json.
+ * - serve: Endpoint of the solver service (unix:<path> or tcp:[host:]port).
+ * - serve_batch: Queued requests a service worker takes per wakeup.
+ * - serve_max_mb: Largest SOLVE payload the service accepts, in MiB.
+ * - deadline_ms: Time budget of a case in single and batch mode, default
+ *   deadline of service requests (0 = none).
+ * - cache_mb: Capacity of the result cache in batch and service mode (0 = no cache).
  */
 struct Config {
   std::string input_path;
 	std::string output_path;
 	double uav_Speed = 2.0;
 	double wait_Time = 10.0;
+  SolverMode solver_mode = SolverMode::Baseline;
+  SimdLevel simd_level = detectSimdLevel();
+  Precision precision = Precision::Double;
+  bool verify_precision = false;
+  bool verify = false;
+  double verify_tolerance = 1e-9;
+  int verify_every = 1;
+  std::shared_ptr<const CostModel> cost_model;
+  int top_k = 1;
+  int drones = 1;
+  FleetObjective fleet_objective = FleetObjective::TotalTime;
+  int threads = 1;
+  int max_skip = -1;
+  int block_size = 8;
+  int tile_size = 0;
+  bool stream = false;
+  bool multi_case = false;
+  bool low_memory = false;
+  std::string batch_source;
+  std::string batch_output_dir;
+  bool convert = false;
+  bool float32 = false;
+  OutputFormat output_format = OutputFormat::Text;
+  std::vector<UavParameters> sweep;
+  bool profile = false;
+  bool stats_json = false;
+  std::string serve;
+  int serve_batch = 8;
+  double serve_max_mb = 64.0;
+  double deadline_ms = 0.0;
+  double cache_mb = 0.0;
 };
 
+/**
+ * parse_number: Converts a whole command-line token with std::from_chars:
+ * no locale, no intermediate stream, and nothing is truncated, so a speed
+ * of "2.5" stays 2.5 and "3x" is rejected.
+ * - Throws runtime_error naming the argument for malformed, out-of-range or
+ *   non-finite values.
+ */
+template <typename T>
+T parse_number(const std::string& text, const char* what) {
+  T value{};
+  const char* first = text.data();
+  const char* last = first + text.size();
+  if (first < last && *first == '+') ++first;  // from_chars rejects a leading '+'
+  const auto [ptr, ec] = std::from_chars(first, last, value);
+  bool valid = ec == std::errc() && ptr == last && first != last;
+  if constexpr (std::is_floating_point<T>::value) valid = valid && std::isfinite(value);
+  if (!valid) {
+    throw std::runtime_error("Invalid " + std::string(what) + " '" + text + "' (expected " +
+      (std::is_integral<T>::value ? "an integer" : "a number") + ")");
+  }
+  return value;
+}
+
+/**
+ * parse_solver_mode: Maps the value of --solver to a SolverMode.
+ * - Throws runtime_error for unknown solver names.
+ */
+SolverMode parse_solver_mode(const std::string& name) {
+  if (name == "baseline") return SolverMode::Baseline;
+  if (name == "pruned") return SolverMode::Pruned;
+  if (name == "simd") return SolverMode::Simd;
+  if (name == "parallel") return SolverMode::Parallel;
+  if (name == "window") return SolverMode::Window;
+  if (name == "separable") return SolverMode::Separable;
+  if (name == "spatial") return SolverMode::Spatial;
+  if (name == "gpu") return SolverMode::Gpu;
+  throw std::runtime_error("Unknown solver '" + name + "' (expected baseline, pruned, simd, parallel, window, separable, spatial or gpu)");
+}
+
+/**
+ * parse_simd_level: Maps the value of --simd to a SimdLevel.
+ * - "auto" selects the widest kernel supported by the running CPU.
+ * - Throws runtime_error for unknown names.
+ */
+SimdLevel parse_simd_level(const std::string& name) {
+  if (name == "auto") return detectSimdLevel();
+  if (name == "scalar") return SimdLevel::Scalar;
+  if (name == "avx2") return SimdLevel::Avx2;
+  if (name == "avx512") return SimdLevel::Avx512;
+  throw std::runtime_error("Unknown SIMD level '" + name + "' (expected auto, scalar, avx2 or avx512)");
+}
+
+/**
+ * parse_precision: Maps the value of --precision to a Precision.
+ * - Throws runtime_error for unknown names.
+ */
+Precision parse_precision(const std::string& name) {
+  if (name == "double") return Precision::Double;
+  if (name == "float") return Precision::Float;
+  if (name == "fixed") return Precision::Fixed;
+  throw std::runtime_error("Unknown precision '" + name + "' (expected double, float or fixed)");
+}
+
+/**
+ * parse_cost_model: Maps the value of --cost-model to a CostModel:
+ * euclidean, manhattan, matrix:<file> or speed-profile:<start:speed,...>.
+ * - Throws runtime_error for unknown models, unreadable matrices and
+ *   malformed speed profiles.
+ */
+std::shared_ptr<const CostModel> parse_cost_model(const std::string& spec) {
+  auto model = std::make_shared<CostModel>();
+  std::string error;
+  if (spec == "euclidean") return nullptr;
+  if (spec == "manhattan") {
+    model->kind = CostModelKind::Manhattan;
+  }
+  else if (spec.compare(0, 7, "matrix:") == 0) {
+    if (!loadDistanceMatrix(spec.substr(7), *model, error)) throw std::runtime_error("Invalid --cost-model: " + error);
+  }
+  else if (spec.compare(0, 14, "speed-profile:") == 0) {
+    if (!parseSpeedProfile(spec.substr(14), *model, error)) throw std::runtime_error("Invalid --cost-model: " + error);
+  }
+  else {
+    throw std::runtime_error("Unknown cost model '" + spec +
+      "' (expected euclidean, manhattan, matrix:<file> or speed-profile:<start:speed,...>)");
+  }
+  return model;
+}
+
+/**
+ * parse_output_format: Maps the value of --output-format to an OutputFormat.
+ * - Throws runtime_error for unknown names.
+ */
+OutputFormat parse_output_format(const std::string& name) {
+  if (name == "text") return OutputFormat::Text;
+  if (name == "binary") return OutputFormat::Binary;
+  throw std::runtime_error("Unknown output format '" + name + "' (expected text or binary)");
+}
+
+/**
+ * parse_sweep: Parses a comma-separated list of speed:wait_time pairs,
+ * e.g. "2:10,5:3,20:3", for --sweep.
+ * - Throws runtime_error for malformed pairs or non-positive speeds.
+ */
+std::vector<UavParameters> parse_sweep(const std::string& list) {
+  std::vector<UavParameters> params;
+  size_t begin = 0;
+  while (begin <= list.size()) {
+    const size_t end = std::min(list.find(',', begin), list.size());
+    const std::string pair = list.substr(begin, end - begin);
+    const size_t colon = pair.find(':');
+    if (colon == std::string::npos) {
+      throw std::runtime_error("Invalid --sweep entry '" + pair + "' (expected speed:wait_time)");
+    }
+    const UavParameters p{ parse_number<double>(pair.substr(0, colon), "--sweep speed"),
+      parse_number<double>(pair.substr(colon + 1), "--sweep wait time") };
+    if (!(p.speed > 0.0)) throw std::runtime_error("Invalid --sweep entry '" + pair + "' (speed must be > 0)");
+    params.push_back(p);
+    begin = end + 1;
+  }
+  return params;
+}
+
 /**
  * parse_arguments: Parses command-line arguments.
  * - Validates input and extracts input/output paths, UAV speed, and wait time.
+ * - Options (--solver <name>, --max-skip <k>, --block-size <b>, --tile-size <t>,
+ *   --simd <level>, --precision <p>, --verify-precision, --verify, --verify-tolerance <rel>,
+ *   --verify-every <n>, --cost-model <model>,
+ *   --top-k <k>, --drones <m>, --fleet-objective <obj>, --threads <n>, --batch <source>, --out-dir <dir>, --convert,
+ *   --float32, --output-format <fmt>,
+ *   --sweep <pairs>, --stream, --multi-case, --low-memory, --profile, --stats-json,
+ *   --serve <endpoint>, --serve-batch <n>, --serve-max-mb <mb>, --deadline-ms <ms>, --cache-mb <mb>) may appear
+ *   anywhere on the command line.
+ * - In batch and service mode the input/output paths come from the batch
+ *   source or the requests, so the positional arguments are just
+ *   [uav_speed] [wait_time].
  * - Throws runtime_error for invalid or insufficient arguments.
  */
 Config parse_arguments(int argc, char* argv[]) {
+  const std::string usage = "Usage: " + std::string(argv[0]) +
+    " <input_path> <output_path> [uav_speed] [wait_time]"
+    " [--solver baseline|pruned|simd|parallel|window|separable|spatial|gpu] [--max-skip k] [--block-size b] [--tile-size t] [--stream] [--multi-case] [--low-memory] [--simd auto|scalar|avx2|avx512] [--precision double|float|fixed] [--verify-precision] [--verify] [--verify-tolerance rel] [--cost-model model] [--top-k k] [--drones m] [--fleet-objective total|makespan] [--deadline-ms ms] [--threads n]"
+    " [--output-format text|binary] [--sweep speed:wait,...] [--profile] [--stats-json]\n"
+    "       " + std::string(argv[0]) + " --batch <dir|manifest> [--out-dir dir] [--cache-mb mb] [--verify-every n] [uav_speed] [wait_time] [options]\n"
+    "       " + std::string(argv[0]) + " --serve unix:<path>|tcp:[host:]port [--threads n] [--serve-batch n] [--serve-max-mb mb] [--deadline-ms ms] [--cache-mb mb] [uav_speed] [wait_time] [options]\n"
+    "       " + std::string(argv[0]) + " --convert <text_input> <binary_output> [--float32]";
+
   Config cfg;
-  if (argc < 2) {
-    throw std::runtime_error("Usage: " + std::string(argv[0]) + " <input_path> <output_path> [uav_speed] [wait_time]");
+  std::vector<std::string> positional;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "--solver") {
+      if (i + 1 >= argc) throw std::runtime_error(usage);
+      cfg.solver_mode = parse_solver_mode(argv[++i]);
+    }
+    else if (arg == "--simd") {
+      if (i + 1 >= argc) throw std::runtime_error(usage);
+      cfg.simd_level = parse_simd_level(argv[++i]);
+    }
+    else if (arg == "--precision") {
+      if (i + 1 >= argc) throw std::runtime_error(usage);
+      cfg.precision = parse_precision(argv[++i]);
+    }
+    else if (arg == "--verify-precision") {
+      cfg.verify_precision = true;
+    }
+    else if (arg == "--verify") {
+      cfg.verify = true;
+    }
+    else if (arg == "--verify-tolerance") {
+      if (i + 1 >= argc) throw std::runtime_error(usage);
+      cfg.verify_tolerance = parse_number<double>(argv[++i], "--verify-tolerance");
+      if (cfg.verify_tolerance < 0.0) throw std::runtime_error(usage);
+    }
+    else if (arg == "--verify-every") {
+      if (i + 1 >= argc) throw std::runtime_error(usage);
+      cfg.verify_every = parse_number<int>(argv[++i], "--verify-every");
+      if (cfg.verify_every < 1) throw std::runtime_error(usage);
+      cfg.verify = true;
+    }
+    else if (arg == "--cost-model") {
+      if (i + 1 >= argc) throw std::runtime_error(usage);
+      cfg.cost_model = parse_cost_model(argv[++i]);
+    }
+    else if (arg == "--drones") {
+      if (i + 1 >= argc) throw std::runtime_error(usage);
+      cfg.drones = parse_number<int>(argv[++i], "--drones");
+      if (cfg.drones < 1) throw std::runtime_error(usage);
+    }
+    else if (arg == "--fleet-objective") {
+      if (i + 1 >= argc) throw std::runtime_error(usage);
+      const std::string objective = argv[++i];
+      if (objective == "total") cfg.fleet_objective = FleetObjective::TotalTime;
+      else if (objective == "makespan") cfg.fleet_objective = FleetObjective::Makespan;
+      else throw std::runtime_error("Unknown fleet objective '" + objective + "' (expected total or makespan)");
+    }
+    else if (arg == "--top-k") {
+      if (i + 1 >= argc) throw std::runtime_error(usage);
+      cfg.top_k = parse_number<int>(argv[++i], "--top-k");
+      if (cfg.top_k < 1 || cfg.top_k > DeliveryUAV::kMaxTopRoutes) {
+        throw std::runtime_error("--top-k must be in 1.." + std::to_string(DeliveryUAV::kMaxTopRoutes));
+      }
+    }
+    else if (arg == "--threads") {
+      if (i + 1 >= argc) throw std::runtime_error(usage);
+      cfg.threads = parse_number<int>(argv[++i], "--threads");
+      if (cfg.threads < 0) throw std::runtime_error(usage);
+    }
+    else if (arg == "--max-skip") {
+      if (i + 1 >= argc) throw std::runtime_error(usage);
+      cfg.max_skip = parse_number<int>(argv[++i], "--max-skip");
+      if (cfg.max_skip < 0) throw std::runtime_error(usage);
+    }
+    else if (arg == "--block-size") {
+      if (i + 1 >= argc) throw std::runtime_error(usage);
+      cfg.block_size = parse_number<int>(argv[++i], "--block-size");
+      if (cfg.block_size < 1) throw std::runtime_error(usage);
+    }
+    else if (arg == "--tile-size") {
+      if (i + 1 >= argc) throw std::runtime_error(usage);
+      cfg.tile_size = parse_number<int>(argv[++i], "--tile-size");
+      if (cfg.tile_size < 0) throw std::runtime_error(usage);
+    }
+    else if (arg == "--batch") {
+      if (i + 1 >= argc) throw std::runtime_error(usage);
+      cfg.batch_source = argv[++i];
+    }
+    else if (arg == "--output-format") {
+      if (i + 1 >= argc) throw std::runtime_error(usage);
+      cfg.output_format = parse_output_format(argv[++i]);
+    }
+    else if (arg == "--sweep") {
+      if (i + 1 >= argc) throw std::runtime_error(usage);
+      cfg.sweep = parse_sweep(argv[++i]);
+    }
+    else if (arg == "--convert") {
+      cfg.convert = true;
+    }
+    else if (arg == "--float32") {
+      cfg.float32 = true;
+    }
+    else if (arg == "--stream") {
+      cfg.stream = true;
+    }
+    else if (arg == "--multi-case") {
+      cfg.multi_case = true;
+    }
+    else if (arg == "--low-memory") {
+      cfg.low_memory = true;
+    }
+    else if (arg == "--profile") {
+      cfg.profile = true;
+    }
+    else if (arg == "--stats-json") {
+      cfg.stats_json = true;
+    }
+    else if (arg == "--serve") {
+      if (i + 1 >= argc) throw std::runtime_error(usage);
+      cfg.serve = argv[++i];
+    }
+    else if (arg == "--serve-batch") {
+      if (i + 1 >= argc) throw std::runtime_error(usage);
+      cfg.serve_batch = std::max(1, parse_number<int>(argv[++i], "--serve-batch"));
+    }
+    else if (arg == "--serve-max-mb") {
+      if (i + 1 >= argc) throw std::runtime_error(usage);
+      cfg.serve_max_mb = parse_number<double>(argv[++i], "--serve-max-mb");
+      if (!(cfg.serve_max_mb > 0.0 && cfg.serve_max_mb <= 1024.0)) {
+        throw std::runtime_error("--serve-max-mb must be in (0, 1024]");
+      }
+    }
+    else if (arg == "--cache-mb") {
+      if (i + 1 >= argc) throw std::runtime_error(usage);
+      cfg.cache_mb = parse_number<double>(argv[++i], "--cache-mb");
+      if (cfg.cache_mb < 0.0) throw std::runtime_error(usage);
+    }
+    else if (arg == "--deadline-ms") {
+      if (i + 1 >= argc) throw std::runtime_error(usage);
+      cfg.deadline_ms = parse_number<double>(argv[++i], "--deadline-ms");
+    }
+    else if (arg == "--out-dir") {
+      if (i + 1 >= argc) throw std::runtime_error(usage);
+      cfg.batch_output_dir = argv[++i];
+    }
+    else {
+      positional.push_back(arg);
+    }
   }
-  cfg.input_path = argv[1];
-  cfg.output_path = argv[2];
 
-  if (argc > 3) cfg.uav_Speed = std::stoi(argv[3]);
-  if (argc > 4) cfg.wait_Time = std::stoi(argv[4]);
+  if (cfg.solver_mode == SolverMode::Window && cfg.max_skip < 0) {
+    throw std::runtime_error("--solver window requires --max-skip <k>");
+  }
+  if (cfg.tile_size > 0 && cfg.solver_mode != SolverMode::Simd && cfg.solver_mode != SolverMode::Gpu) {
+    throw std::runtime_error("--tile-size requires --solver simd or gpu");
+  }
+  std::string gpu_description;
+  if (cfg.solver_mode == SolverMode::Gpu && !gpuBackendAvailable(gpu_description)) {
+    throw std::runtime_error("--solver gpu: " + gpu_description);
+  }
+  if (cfg.precision != Precision::Double && cfg.solver_mode != SolverMode::Simd) {
+    throw std::runtime_error("--precision float|fixed requires --solver simd");
+  }
+  if (cfg.cost_model && cfg.solver_mode != SolverMode::Baseline && cfg.solver_mode != SolverMode::Pruned &&
+    cfg.solver_mode != SolverMode::Separable && cfg.solver_mode != SolverMode::Spatial) {
+    throw std::runtime_error("--cost-model requires --solver baseline, pruned, separable or spatial");
+  }
+  if (cfg.cost_model && (cfg.stream || !cfg.sweep.empty())) {
+    throw std::runtime_error("--cost-model cannot be combined with --stream or --sweep");
+  }
+  if (cfg.stream && cfg.solver_mode != SolverMode::Window && cfg.solver_mode != SolverMode::Pruned) {
+    throw std::runtime_error("--stream requires --solver window or --solver pruned");
+  }
+
+  if (cfg.top_k > 1 && (cfg.stream || !cfg.sweep.empty() || !cfg.serve.empty() ||
+    cfg.output_format == OutputFormat::Binary)) {
+    throw std::runtime_error("--top-k cannot be combined with --stream, --sweep, --serve or --output-format binary");
+  }
+  if (cfg.drones > 1 && (cfg.stream || !cfg.sweep.empty() || !cfg.serve.empty() || cfg.top_k > 1 ||
+    cfg.deadline_ms > 0.0 || cfg.cache_mb > 0.0 || cfg.output_format == OutputFormat::Binary)) {
+    throw std::runtime_error("--drones cannot be combined with --stream, --sweep, --serve, --top-k, --deadline-ms, "
+      "--cache-mb or --output-format binary");
+  }
+  if (cfg.deadline_ms > 0.0 && (cfg.stream || !cfg.sweep.empty() || cfg.top_k > 1)) {
+    throw std::runtime_error("--deadline-ms cannot be combined with --stream, --sweep or --top-k");
+  }
+  if (cfg.cache_mb > 0.0 && (cfg.batch_source.empty() && cfg.serve.empty())) {
+    throw std::runtime_error("--cache-mb requires --batch or --serve");
+  }
+  if (cfg.cache_mb > 0.0 && (cfg.stream || cfg.top_k > 1 || !cfg.sweep.empty())) {
+    throw std::runtime_error("--cache-mb cannot be combined with --stream, --sweep or --top-k");
+  }
+  if (cfg.verify && (cfg.solver_mode == SolverMode::Window || cfg.stream || !cfg.sweep.empty() ||
+    !cfg.serve.empty() || cfg.top_k > 1 || cfg.drones > 1 || cfg.deadline_ms > 0.0)) {
+    throw std::runtime_error("--verify cannot be combined with --solver window, --stream, --sweep, --serve, --top-k, "
+      "--drones or --deadline-ms");
+  }
+  if (cfg.multi_case && (cfg.stream || !cfg.sweep.empty() || !cfg.serve.empty() || cfg.top_k > 1 ||
+    cfg.drones > 1 || cfg.cache_mb > 0.0 || cfg.verify || cfg.verify_precision)) {
+    throw std::runtime_error("--multi-case cannot be combined with --stream, --sweep, --serve, --top-k, --drones, "
+      "--cache-mb, --verify or --verify-precision");
+  }
+  if (cfg.stream && !cfg.serve.empty()) {
+    throw std::runtime_error("--stream cannot be combined with --serve");
+  }
+
+  size_t next = 0;
+  if (cfg.batch_source.empty() && cfg.serve.empty()) {
+    if (positional.size() < 2) {
+      throw std::runtime_error(usage);
+    }
+    cfg.input_path = positional[next++];
+    cfg.output_path = positional[next++];
+  }
+
+  if (positional.size() > next) {
+    cfg.uav_Speed = parse_number<double>(positional[next], "uav_speed");
+    if (!(cfg.uav_Speed > 0.0)) throw std::runtime_error("Invalid uav_speed '" + positional[next] + "' (must be > 0)");
+    ++next;
+  }
+  if (positional.size() > next) {
+    cfg.wait_Time = parse_number<double>(positional[next], "wait_time");
+    if (cfg.wait_Time < 0.0) throw std::runtime_error("Invalid wait_time '" + positional[next] + "' (must be >= 0)");
+    ++next;
+  }
+  if (positional.size() > next) throw std::runtime_error("Unexpected argument '" + positional[next] + "'\n" + usage);
   return cfg;
 }
 
@@ -41,15 +478,154 @@ Config parse_arguments(int argc, char* argv[]) {
  * 2. Loads input data using the input path.
  * 3. Initializes the UAV and finds the optimal path's time for the given case:
  * 4. Prints out the results in the output file.
+ * 5. Reports the number of DP candidates evaluated on stdout (plus phase
+ *    timings and counters with --profile).
+ * In batch mode (--batch), steps 2-5 run for every case of the batch on a
+ * shared work-stealing pool of --threads workers. With --convert, the text
+ * input is only converted into the binary route format. With --sweep, the
+ * input is loaded once and solved for every listed parameter set. With
+ * --serve, the program runs as a solver service until a client sends SHUTDOWN.
  */
 int main(int argc, char* argv[]) {
 
-  Config cfg = parse_arguments(argc, argv);
+  Config cfg;
+  try {
+    cfg = parse_arguments(argc, argv);
+  }
+  catch (const std::exception& e) {
+    std::cerr << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
 
-  const std::string input_file = cfg.input_path;
-  const std::string output_file = cfg.output_path;
+  if (cfg.convert) {
+    return convertTextToBinary(cfg.input_path, cfg.output_path, cfg.float32);
+  }
 
-  // Use the fully qualified name for DeliveryUAV
-  auto uav = DeliveryUAV::DeliveryUAV(cfg.uav_Speed, cfg.wait_Time);
-  return uav.solveCase(cfg.input_path, cfg.output_path);
-}
\ No newline at end of file
+  if (!cfg.serve.empty()) {
+    ServiceConfig service;
+    service.endpoint = cfg.serve;
+    service.workers = cfg.threads > 0 ? cfg.threads : (int)std::max(1u, std::thread::hardware_concurrency());
+    service.max_batch = cfg.serve_batch;
+    service.default_deadline_ms = cfg.deadline_ms;
+    service.max_payload_bytes = (std::size_t)(cfg.serve_max_mb * 1048576.0);
+    if (cfg.cache_mb > 0.0) service.cache = std::make_shared<ResultCache>((std::size_t)(cfg.cache_mb * 1048576.0));
+    return runSolverService(service, [&cfg] {
+      DeliveryUAV uav(cfg.uav_Speed, cfg.wait_Time);  // one worker per request
+      uav.setSolverMode(cfg.solver_mode);
+      uav.setMaxSkip(cfg.max_skip);
+      uav.setBlockSize(cfg.block_size);
+      uav.setTileSize(cfg.tile_size);
+      uav.setLowMemory(cfg.low_memory);
+      uav.setSimdLevel(cfg.simd_level);
+      uav.setPrecision(cfg.precision);
+      uav.setCostModel(cfg.cost_model);
+      return uav;
+    });
+  }
+
+  if (!cfg.sweep.empty() && cfg.batch_source.empty()) {
+    SolveStats stats;
+    const int status = solveSweepCase(cfg.input_path, cfg.output_path, cfg.sweep, &stats);
+    if (status == EXIT_SUCCESS) {
+      std::cout << "Candidate pairs evaluated: " << stats.candidates_evaluated
+        << " (shared by " << cfg.sweep.size() << " parameter sets)\n";
+    }
+    return status;
+  }
+
+  if (!cfg.batch_source.empty()) {
+    std::vector<BatchJob> jobs;
+    if (!collectBatchJobs(cfg.batch_source, cfg.batch_output_dir, jobs)) {
+      return EXIT_FAILURE;
+    }
+    DeliveryUAV uav(cfg.uav_Speed, cfg.wait_Time);  // rows are split on the batch pool
+    uav.setSolverMode(cfg.solver_mode);
+    uav.setMaxSkip(cfg.max_skip);
+    uav.setBlockSize(cfg.block_size);
+    uav.setTileSize(cfg.tile_size);
+    uav.setStreaming(cfg.stream);
+    uav.setMultiCase(cfg.multi_case);
+    uav.setLowMemory(cfg.low_memory);
+    uav.setSimdLevel(cfg.simd_level);
+    uav.setPrecision(cfg.precision);
+    uav.setCostModel(cfg.cost_model);
+    uav.setTopRoutes(cfg.top_k);
+    uav.setFleet(cfg.drones, cfg.fleet_objective);
+    uav.setDeadline(cfg.deadline_ms);
+    if (cfg.cache_mb > 0.0) uav.setResultCache(std::make_shared<ResultCache>((std::size_t)(cfg.cache_mb * 1048576.0)));
+    uav.setOutputFormat(cfg.output_format);
+    uav.setProfiling(cfg.profile, cfg.stats_json);
+    return runBatch(uav, jobs, cfg.threads, cfg.verify ? cfg.verify_every : 0, cfg.verify_tolerance);
+  }
+
+  DeliveryUAV uav(cfg.uav_Speed, cfg.wait_Time, cfg.threads);
+  uav.setSolverMode(cfg.solver_mode);
+  uav.setMaxSkip(cfg.max_skip);
+  uav.setBlockSize(cfg.block_size);
+  uav.setTileSize(cfg.tile_size);
+  uav.setStreaming(cfg.stream);
+  uav.setMultiCase(cfg.multi_case);
+  uav.setLowMemory(cfg.low_memory);
+  uav.setSimdLevel(cfg.simd_level);
+  uav.setPrecision(cfg.precision);
+  uav.setCostModel(cfg.cost_model);
+  uav.setTopRoutes(cfg.top_k);
+  uav.setFleet(cfg.drones, cfg.fleet_objective);
+  uav.setDeadline(cfg.deadline_ms);
+  uav.setOutputFormat(cfg.output_format);
+  uav.setProfiling(cfg.profile, cfg.stats_json);
+
+  SolveStats stats;
+  const int status = uav.solveCase(cfg.input_path, cfg.output_path, &stats);
+  if (status == EXIT_SUCCESS) {
+    std::cout << "Candidates evaluated: " << stats.candidates_evaluated << '\n';
+    if (cfg.multi_case) std::cout << "Cases solved: " << stats.cases << '\n';
+    if (cfg.stream) std::cout << "Peak frontier: " << stats.peak_frontier << " waypoints\n";
+    if (cfg.solver_mode == SolverMode::Spatial) std::cout << "Blocks skipped: " << stats.blocks_skipped << '\n';
+    if (cfg.deadline_ms > 0.0) {
+      if (stats.proven_optimal) std::cout << "Optimal: yes\n";
+      else std::cout << "Optimal: no (gap " << stats.optimality_gap * 100.0 << "%)\n";
+    }
+    if (cfg.profile) {
+      // One key=value per line, for scripts grepping the console output
+      for (int p = 0; p < static_cast<int>(SolvePhase::Count); ++p) {
+        std::cout << "phase." << solvePhaseName(static_cast<SolvePhase>(p)) << "_us=" << stats.phase_us[p] << '\n';
+      }
+      std::cout << "total_us=" << stats.total_us << '\n'
+        << "bytes_read=" << stats.bytes_read << '\n'
+        << "peak_rss_kb=" << stats.peak_rss_kb << '\n';
+    }
+    if (cfg.verify_precision) {
+      RouteFile route;
+      std::string error;
+      if (!route.open(cfg.input_path, error)) {
+        std::cerr << "Error opening input file: " << cfg.input_path << '\n';
+        return EXIT_FAILURE;
+      }
+      const PrecisionReport report = verifyPrecision(uav, route.columns());
+      std::cout << "Precision check (" << precisionName(report.precision) << " vs double): time "
+        << std::fixed << std::setprecision(6) << report.time << " vs " << report.reference_time
+        << std::scientific << std::setprecision(3) << " (abs diff " << std::fabs(report.time - report.reference_time)
+        << "), ";
+      if (report.first_divergence < 0) {
+        std::cout << "path identical (" << report.path_length << " points)\n";
+      }
+      else {
+        std::cout << "path diverges at position " << report.first_divergence << " ("
+          << report.path_length << " vs " << report.reference_length << " points)\n";
+      }
+    }
+    if (cfg.verify) {
+      RouteFile route;
+      std::string error;
+      if (!route.open(cfg.input_path, error)) {
+        std::cerr << "Error opening input file: " << cfg.input_path << '\n';
+        return EXIT_FAILURE;
+      }
+      const VerifyReport report = verifySolve(uav, route.columns(), cfg.verify_tolerance);
+      printVerifyReport(std::cout, report);
+      if (!report.passed()) return EXIT_FAILURE;
+    }
+  }
+  return status;
+}
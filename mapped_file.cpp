@@ -0,0 +1,78 @@
+#include "mapped_file.h"
+#include <fstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define DUAV_HAVE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile()
+{
+  close();
+}
+
+/**
+ * @brief Maps (or reads) the file at `path`
+ *
+ * @param path File to open
+ * @return bool False if the file cannot be opened or read
+ */
+bool MappedFile::open(const std::string& path)
+{
+  close();
+
+#if defined(DUAV_HAVE_MMAP)
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) return false;
+
+  struct stat info;
+  if (::fstat(fd, &info) == 0 && S_ISREG(info.st_mode)) {
+    if (info.st_size == 0) {  // mmap rejects empty files
+      ::close(fd);
+      data_ = "";
+      return true;
+    }
+    void* addr = ::mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr != MAP_FAILED) {
+      ::madvise(addr, (size_t)info.st_size, MADV_SEQUENTIAL);
+      ::close(fd);
+      data_ = static_cast<const char*>(addr);
+      size_ = (size_t)info.st_size;
+      mapped_ = true;
+      return true;
+    }
+  }
+  ::close(fd);
+#endif
+
+  return readIntoBuffer(path);
+}
+
+void MappedFile::close()
+{
+#if defined(DUAV_HAVE_MMAP)
+  if (mapped_) ::munmap(const_cast<char*>(data_), size_);
+#endif
+  data_ = nullptr;
+  size_ = 0;
+  mapped_ = false;
+  buffer_.clear();
+}
+
+bool MappedFile::readIntoBuffer(const std::string& path)
+{
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open()) return false;
+
+  buffer_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  if (file.bad()) {
+    buffer_.clear();
+    return false;
+  }
+  data_ = buffer_.empty() ? "" : buffer_.data();
+  size_ = buffer_.size();
+  return true;
+}
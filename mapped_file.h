@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * MappedFile: read-only view of a whole file.
+ *
+ * Memory-maps the file where the platform supports it and falls back to
+ * reading it into an owned buffer otherwise (or when mapping fails, e.g. for
+ * pipes). Either way data()/size() expose the bytes without further copies.
+ */
+class MappedFile {
+public:
+  MappedFile() = default;
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  bool open(const std::string& path);
+  void close();
+
+  const char* data() const { return data_; }
+  std::size_t size() const { return size_; }
+  bool isMapped() const { return mapped_; }
+
+private:
+  bool readIntoBuffer(const std::string& path);
+
+  const char* data_ = nullptr;
+  std::size_t size_ = 0;
+  bool mapped_ = false;
+  std::vector<char> buffer_;
+};
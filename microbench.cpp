@@ -0,0 +1,169 @@
+#include "delivery_uav.h"
+#include "route_file.h"
+#include "route_generator.h"
+#include "simd_kernels.h"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * MicroConfig: Structure to hold the parameters of a microbenchmark run.
+ * - input_path: Route file (text or binary) to solve; empty = generated route.
+ * - spec: Synthetic route used without an input file (see route_generator.h).
+ * - solver_mode: Solver to time (default: baseline, the reference DP).
+ * - warmup / repetitions: Untimed and timed solves.
+ * - threads: Threads of the parallel solver (default: 1, 0 = all cores).
+ * - uav_speed / wait_time: UAV parameters (default: 2 m/s, 10 s).
+ */
+struct MicroConfig {
+  std::string input_path;
+  RouteSpec spec;
+  SolverMode solver_mode = SolverMode::Baseline;
+  int warmup = 1;
+  int repetitions = 20;
+  int threads = 1;
+  double uav_speed = 2.0;
+  double wait_time = 10.0;
+};
+
+const char* solver_name(SolverMode mode) {
+  switch (mode) {
+  case SolverMode::Pruned:    return "pruned";
+  case SolverMode::Simd:      return "simd";
+  case SolverMode::Parallel:  return "parallel";
+  case SolverMode::Window:    return "window";
+  case SolverMode::Separable: return "separable";
+  case SolverMode::Spatial:   return "spatial";
+  case SolverMode::Gpu:       return "gpu";
+  case SolverMode::Baseline:  break;
+  }
+  return "baseline";
+}
+
+SolverMode parse_solver(const std::string& name) {
+  for (SolverMode mode : { SolverMode::Baseline, SolverMode::Pruned, SolverMode::Simd, SolverMode::Parallel,
+    SolverMode::Separable, SolverMode::Spatial, SolverMode::Gpu }) {
+    if (name == solver_name(mode)) return mode;
+  }
+  throw std::runtime_error("Unknown solver '" + name + "' (expected baseline, pruned, simd, parallel, separable, "
+    "spatial or gpu)");
+}
+
+template <typename T>
+T parse_number(const std::string& text, const char* what) {
+  T value{};
+  const auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+  if (ec != std::errc() || ptr != text.data() + text.size() || text.empty()) {
+    throw std::runtime_error("Invalid " + std::string(what) + " '" + text + "'");
+  }
+  return value;
+}
+
+/**
+ * parse_arguments: Parses the microbenchmark options; every option is optional.
+ * - Throws runtime_error for unknown options or values.
+ */
+MicroConfig parse_arguments(int argc, char* argv[]) {
+  const std::string usage = "Usage: " + std::string(argv[0]) +
+    " [--input route] [--waypoints n] [--shape uniform|clustered|corridor] [--penalties light|heavy] [--seed s]"
+    " [--solver baseline|pruned|simd|parallel|separable|spatial|gpu] [--warmup n] [--reps n] [--threads n]"
+    " [--speed v] [--wait t]";
+
+  MicroConfig cfg;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (i + 1 >= argc) throw std::runtime_error(usage);
+    const std::string value = argv[++i];
+
+    if (arg == "--input") cfg.input_path = value;
+    else if (arg == "--waypoints") cfg.spec.waypoints = std::max(1, parse_number<int>(value, "--waypoints"));
+    else if (arg == "--shape") {
+      if (!parseRouteShape(value, cfg.spec.shape)) throw std::runtime_error("Unknown shape '" + value + "'");
+    }
+    else if (arg == "--penalties") {
+      if (!parsePenaltyProfile(value, cfg.spec.penalties)) throw std::runtime_error("Unknown penalties '" + value + "'");
+    }
+    else if (arg == "--seed") cfg.spec.seed = parse_number<std::uint64_t>(value, "--seed");
+    else if (arg == "--solver") cfg.solver_mode = parse_solver(value);
+    else if (arg == "--warmup") cfg.warmup = std::max(0, parse_number<int>(value, "--warmup"));
+    else if (arg == "--reps") cfg.repetitions = std::max(1, parse_number<int>(value, "--reps"));
+    else if (arg == "--threads") cfg.threads = std::max(0, parse_number<int>(value, "--threads"));
+    else if (arg == "--speed") cfg.uav_speed = parse_number<double>(value, "--speed");
+    else if (arg == "--wait") cfg.wait_time = parse_number<double>(value, "--wait");
+    else throw std::runtime_error(usage);
+  }
+  if (!(cfg.uav_speed > 0.0)) throw std::runtime_error("--speed must be > 0");
+  return cfg;
+}
+
+/**
+ * main: Microbenchmark entry point.
+ * Workflow:
+ * 1. Loads the route once (or generates it), outside the timed region.
+ * 2. Runs --warmup untimed and --reps timed DeliveryUAV::solveRoute calls:
+ *    the DP and path reconstruction only, without parsing or file output.
+ * 3. Prints the median, minimum and maximum solve time, the time per
+ *    evaluated candidate and the optimal time.
+ * Meant as a stable target for perf and for profile-guided training, e.g.
+ *   perf record -g ./microbench_profile --input examples/large3.txt --reps 2000
+ */
+int main(int argc, char* argv[]) {
+  MicroConfig cfg;
+  try {
+    cfg = parse_arguments(argc, argv);
+  }
+  catch (const std::exception& e) {
+    std::cerr << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+
+  RouteFile input;
+  WaypointSoA generated;
+  WaypointColumns cols;
+  if (!cfg.input_path.empty()) {
+    std::string error;
+    if (!input.open(cfg.input_path, error)) {
+      std::cerr << error << '\n';
+      return EXIT_FAILURE;
+    }
+    cols = input.columns();
+  }
+  else {
+    generated = generateRoute(cfg.spec);
+    cols = generated.columns();
+  }
+
+  DeliveryUAV uav(cfg.uav_speed, cfg.wait_time, cfg.threads);
+  uav.setSolverMode(cfg.solver_mode);
+
+  std::vector<int> path;
+  SolveStats stats;
+  double total_time = 0.0;
+  for (int r = 0; r < cfg.warmup; ++r) total_time = uav.solveRoute(cols, path);
+
+  std::vector<double> times_ms(cfg.repetitions);
+  for (int r = 0; r < cfg.repetitions; ++r) {
+    const auto start = std::chrono::steady_clock::now();
+    total_time = uav.solveRoute(cols, path, &stats);
+    times_ms[r] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  }
+  std::sort(times_ms.begin(), times_ms.end());
+  const double median_ms = times_ms[times_ms.size() / 2];
+
+  std::cout << "Route: " << (cfg.input_path.empty() ? std::string("generated ") + routeShapeName(cfg.spec.shape) + " " +
+    penaltyProfileName(cfg.spec.penalties) : cfg.input_path) << ", " << cols.count - 2 << " waypoints\n"
+    << "Solver: " << solver_name(cfg.solver_mode) << " (SIMD level " << simdLevelName(uav.simdLevel())
+    << ", threads " << uav.threads() << ")\n"
+    << std::fixed << std::setprecision(3)
+    << "Solve ms: median " << median_ms << ", min " << times_ms.front() << ", max " << times_ms.back()
+    << " over " << cfg.repetitions << " runs\n"
+    << "Candidates evaluated: " << stats.candidates_evaluated << " ("
+    << (stats.candidates_evaluated > 0 ? median_ms * 1e6 / stats.candidates_evaluated : 0.0) << " ns each)\n"
+    << "Minimum UAV time: " << total_time << '\n';
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,237 @@
+#include "delivery_uav.h"
+#include "binary_route.h"
+#include "bounded_queue.h"
+#include "cost_model.h"
+#include "mapped_file.h"
+#include "result_writer.h"
+#include "solve_profile.h"
+#include "waypoint_loader.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+namespace {
+
+// Cases in flight: one parsed, one solved and one written, plus one queued
+// ahead of the solver and one ahead of the writer
+constexpr std::size_t kCaseSlots = 5;
+
+/**
+ * CaseSlot: one case travelling through the pipeline. Slots are recycled
+ * once written, so the columns and paths stop allocating after the largest
+ * case has been seen.
+ */
+struct CaseSlot {
+  WaypointSoA soa;
+  std::vector<int> path;
+  double total_time = 0.0;
+  long long parse_us = 0;
+  long long solve_us = 0;
+};
+
+using SlotQueue = BoundedQueue<CaseSlot*>;
+
+inline long long elapsedUs(std::chrono::steady_clock::time_point since)
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - since).count();
+}
+
+} // namespace
+
+
+/**
+ * @brief Solves every case of a multi-case text file in a three-stage
+ *        pipeline and writes their solutions, in order, to one output file
+ *
+ * A parser thread reads case k + 1 (WaypointCaseReader, over the memory
+ * mapping) while the calling thread solves case k with the configured solver
+ * (and deadline), and a writer thread formats and writes case k - 1. Cases
+ * flow through bounded queues in a fixed pool of slots, so memory holds at
+ * most five cases however many the file contains. The output is the
+ * concatenation of the single-case reports; the execution time of each
+ * report covers parsing and solving that case.
+ *
+ * @param input_file_name  Multi-case text file (see WaypointCaseReader::reset)
+ * @param output_file_name Output file, one solveCase() report per case
+ * @param stats            Optional sink for counters summed over the cases
+ * @return int Status code: 0 for success, 1 for errors
+ */
+int DeliveryUAV::solveMultiCase(
+  const std::string& input_file_name,
+  const std::string& output_file_name,
+  SolveStats* stats) const
+{
+  const auto start_time = std::chrono::steady_clock::now();
+  SolveStats case_stats;
+
+  if (top_routes_ > 1 || fleet_drones_ > 1) {
+    std::cerr << "Multi-case input cannot be combined with top-k routes or a fleet\n";
+    return EXIT_FAILURE;
+  }
+  MappedFile input_file;
+  if (!input_file.open(input_file_name)) {
+    std::cerr << "Error opening input file: " << input_file_name << '\n';
+    return EXIT_FAILURE;
+  }
+  if (isBinaryRoute(input_file.data(), input_file.size())) {
+    std::cerr << "Multi-case input requires a text file: " << input_file_name << '\n';
+    return EXIT_FAILURE;
+  }
+  WaypointCaseReader reader;
+  std::string parse_error;
+  if (!reader.reset(input_file.data(), input_file.data() + input_file.size(), parse_error)) {
+    std::cerr << "Invalid input format in " << input_file_name << ", " << parse_error << '\n';
+    return EXIT_FAILURE;
+  }
+
+  std::ofstream output_file(output_file_name,
+    output_format_ == OutputFormat::Binary ? std::ios::out | std::ios::binary : std::ios::out);
+  if (!output_file.is_open()) {
+    std::cerr << "Error opening output file: " << output_file_name << '\n';
+    return EXIT_FAILURE;
+  }
+
+  std::vector<CaseSlot> slots(kCaseSlots);
+  SlotQueue free_slots(kCaseSlots);
+  SlotQueue parsed(1);
+  SlotQueue solved(1);
+  for (CaseSlot& slot : slots) free_slots.push(&slot);
+
+  // ----------------------
+  // Parser thread: case k + 1
+  // ----------------------
+  bool parse_failed = false;  // read by the solver only after join()
+  std::thread parser([&] {
+    CaseSlot* slot = nullptr;
+    while (free_slots.pop(slot)) {
+      const auto parse_start = std::chrono::steady_clock::now();
+      bool done = false;
+      if (!reader.next(slot->soa, done, parse_error)) {
+        parse_failed = true;
+        break;
+      }
+      if (done) break;
+      slot->parse_us = elapsedUs(parse_start);
+      if (!parsed.push(std::move(slot))) break;
+    }
+    parsed.close();
+  });
+
+  // ----------------------
+  // Writer thread: case k - 1
+  // ----------------------
+  std::atomic<bool> write_failed{ false };
+  long long output_us = 0;
+  std::thread writer([&] {
+    ResultWriter result_writer;
+    CaseSlot* slot = nullptr;
+    while (solved.pop(slot)) {
+      const auto output_start = std::chrono::steady_clock::now();
+      if (!write_failed.load()) {
+        const long long execution_ms = (slot->parse_us + slot->solve_us) / 1000;
+        if (output_format_ == OutputFormat::Binary) {
+          result_writer.formatBinary(execution_ms, slot->total_time, slot->path);
+        }
+        else {
+          result_writer.formatText(execution_ms, slot->total_time, slot->path);
+        }
+        if (!result_writer.writeTo(output_file)) write_failed = true;
+      }
+      output_us += elapsedUs(output_start);
+      free_slots.push(std::move(slot));
+    }
+  });
+
+  // ----------------------
+  // Core Algorithm Execution: case k
+  // ----------------------
+  std::string solve_error;
+  long long cases = 0;
+  long long parse_us = 0;
+  CaseSlot* slot = nullptr;
+  AnytimeResult anytime;
+  while (parsed.pop(slot)) {
+    const WaypointColumns cols = slot->soa.columns();
+    if (write_failed.load()) {
+      free_slots.push(std::move(slot));
+      break;
+    }
+    if (cost_model_ && cost_model_->kind == CostModelKind::DistanceMatrix && cost_model_->matrix_size != cols.count) {
+      solve_error = "Distance matrix has " + std::to_string(cost_model_->matrix_size) + " points, case " +
+        std::to_string(cases + 1) + " of " + input_file_name + " has " + std::to_string(cols.count) +
+        " (start, waypoints and terminal)";
+      free_slots.push(std::move(slot));
+      break;
+    }
+
+    const auto solve_start = std::chrono::steady_clock::now();
+    SolveStats route_stats;
+    try {  // an escaping exception would leave the parser and writer unjoined
+      if (deadline_ms_ > 0.0) {
+        solveWithinDeadline(cols, deadline_ms_, anytime, &route_stats);
+        slot->total_time = anytime.total_time;
+        slot->path = anytime.path;
+      }
+      else {
+        slot->total_time = solveRoute(cols, slot->path, &route_stats);
+      }
+    }
+    catch (const std::exception& e) {
+      solve_error = "Error solving case " + std::to_string(cases + 1) + " of " + input_file_name + ": " + e.what();
+      free_slots.push(std::move(slot));
+      break;
+    }
+    slot->solve_us = elapsedUs(solve_start);
+
+    ++cases;
+    parse_us += slot->parse_us;
+    case_stats.candidates_evaluated += route_stats.candidates_evaluated;
+    case_stats.blocks_skipped += route_stats.blocks_skipped;
+    case_stats.proven_optimal = case_stats.proven_optimal && route_stats.proven_optimal;
+    case_stats.optimality_gap = std::max(case_stats.optimality_gap, route_stats.optimality_gap);
+    if (profiling_) {
+      case_stats.phase_us[static_cast<int>(SolvePhase::Dp)] += slot->solve_us;
+    }
+    solved.push(std::move(slot));
+  }
+  parsed.cancel();  // stops the parser if the loop ended early
+  solved.close();
+  parser.join();
+  writer.join();
+
+  if (parse_failed) {
+    std::cerr << "Invalid input format in " << input_file_name << ", " << parse_error << '\n';
+    return EXIT_FAILURE;
+  }
+  if (!solve_error.empty()) {
+    std::cerr << solve_error << '\n';
+    return EXIT_FAILURE;
+  }
+  if (write_failed.load()) {
+    std::cerr << "Error writing output file: " << output_file_name << '\n';
+    return EXIT_FAILURE;
+  }
+  output_file.close();
+
+  case_stats.cases = cases;
+  case_stats.bytes_read = (long long)input_file.size();
+  input_file.close();
+  if (profiling_) {
+    // Load and Output overlap Dp: they ran on the parser and writer threads
+    case_stats.phase_us[static_cast<int>(SolvePhase::Load)] = parse_us;
+    case_stats.phase_us[static_cast<int>(SolvePhase::Output)] = output_us;
+    case_stats.total_us = elapsedUs(start_time);
+    case_stats.peak_rss_kb = peakResidentKiB();
+    if (stats_sidecar_ && !writeStatsJson(output_file_name + ".stats.json", input_file_name, case_stats)) {
+      std::cerr << "Error writing stats file: " << output_file_name << ".stats.json\n";
+      return EXIT_FAILURE;
+    }
+  }
+  if (stats) *stats = case_stats;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <functional>
+
+/**
+ * ParallelExecutor: fork-join interface used by the solver to split the
+ * predecessor range of a single waypoint across threads.
+ * - concurrency(): number of tasks that can run at the same time.
+ * - parallelFor(): runs task(0) .. task(tasks - 1) and returns once all of
+ *   them have finished. The calling thread participates.
+ */
+class ParallelExecutor {
+public:
+  virtual ~ParallelExecutor() = default;
+  virtual int concurrency() const = 0;
+  virtual void parallelFor(int tasks, const std::function<void(int)>& task) = 0;
+};
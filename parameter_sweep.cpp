@@ -0,0 +1,166 @@
+#include "parameter_sweep.h"
+#include "result_writer.h"
+#include "route_file.h"
+#include "solve_workspace.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <limits>
+
+/**
+ * @brief Solves one route for K (speed, wait time) parameter sets in one pass
+ *
+ * Runs the pruned recurrence of DeliveryUAV (see solvePruned) for all K
+ * parameter sets together. The K DP rows are interleaved (dp[j * K + k]), so
+ * each predecessor j is visited once per waypoint i: its distance and
+ * skipped-penalty sum are computed once and shared by all K sets, and the
+ * inner loop over k runs over contiguous memory without branches, which the
+ * compiler vectorizes. The backward scan over j stops once the pruning bound
+ * rules out every remaining predecessor for all K sets.
+ *
+ * Each result is identical to a separate pruned (or baseline) solve with the
+ * same parameters, including the smallest-index tie-break.
+ *
+ * Time Complexity: O(K * N^2) worst case, close to O(K * N) in practice
+ *
+ * @param cols    Columns of [start, wp1, wp2..., terminal] with penalty prefix sums
+ * @param params  Parameter sets; speeds must be > 0
+ * @param results   Receives one result per parameter set, in order
+ * @param stats     Optional sink; counts (j, i) pairs, each shared by all K sets
+ * @param workspace Scratch buffers to reuse; nullptr uses one workspace per thread
+ */
+void solveSweep(const WaypointColumns& cols, const std::vector<UavParameters>& params,
+  std::vector<SweepResult>& results, SolveStats* stats, SolveWorkspace* workspace)
+{
+  const int K = (int)params.size();
+  const int total_points = cols.count - 1;
+  results.resize(K);
+  if (K == 0) return;
+
+  thread_local SolveWorkspace thread_workspace;
+  SolveWorkspace& ws = workspace ? *workspace : thread_workspace;
+  std::vector<double>& sweep_params = ws.sweep_params;
+  sweep_params.resize((size_t)2 * K);
+  double* inv_speed = sweep_params.data();  // 1 / speed, as EuclideanCost
+  double* wait = inv_speed + K;
+  for (int k = 0; k < K; ++k) {
+    inv_speed[k] = 1.0 / params[k].speed;
+    wait[k] = params[k].wait_time;
+  }
+
+  AlignedVector<double>& dp = ws.dp;
+  dp.assign((size_t)(total_points + 1) * K, 0.0);
+  std::vector<double>& floor = ws.floor;  // min over j' <= j of dp - prefix
+  floor.assign((size_t)(total_points + 1) * K, 0.0);
+  std::vector<int>& prev_waypoint = ws.prev_waypoint;
+  prev_waypoint.assign((size_t)(total_points + 1) * K, -1);
+  std::vector<double>& min_time = ws.sweep_min_time;
+  min_time.resize(K);
+  std::vector<int>& best_prev = ws.sweep_best_prev;
+  best_prev.resize(K);
+
+  long long pairs = 0;
+  for (int i = 1; i <= total_points; ++i) {
+    std::fill(min_time.begin(), min_time.end(), std::numeric_limits<double>::max());
+    std::fill(best_prev.begin(), best_prev.end(), -1);
+    const double penalties_before_i = cols.prefix[i - 1];
+
+    for (int j = i - 1; j >= 0; --j) {
+      const double* floor_j = &floor[(size_t)j * K];
+      bool any_open = false;
+      for (int k = 0; k < K; ++k) {
+        any_open |= !(floor_j[k] + penalties_before_i - min_time[k] > 1e-12 * std::fabs(min_time[k]));
+      }
+      if (!any_open) break;
+
+      const double distance = std::hypot(cols.x[i] - cols.x[j], cols.y[i] - cols.y[j]);
+      const double sum_pen = penalties_before_i - cols.prefix[j];
+      const double* dp_j = &dp[(size_t)j * K];
+      ++pairs;
+
+      // '<=' while scanning downwards keeps the smallest j among equal times
+      for (int k = 0; k < K; ++k) {
+        const double time_candidate = dp_j[k] + distance * inv_speed[k] + sum_pen;
+        const bool better = time_candidate <= min_time[k];
+        min_time[k] = better ? time_candidate : min_time[k];
+        best_prev[k] = better ? j : best_prev[k];
+      }
+    }
+
+    double* dp_i = &dp[(size_t)i * K];
+    double* floor_i = &floor[(size_t)i * K];
+    const double* floor_prev = &floor[(size_t)(i - 1) * K];
+    for (int k = 0; k < K; ++k) {
+      dp_i[k] = min_time[k] + wait[k];
+      prev_waypoint[(size_t)i * K + k] = best_prev[k];
+      floor_i[k] = std::min(floor_prev[k], dp_i[k] - cols.prefix[i]);
+    }
+  }
+
+  // Count the points, then fill each path back to front (see reconstructPath)
+  for (int k = 0; k < K; ++k) {
+    std::size_t length = 1;
+    for (int current = total_points; current != 0; current = prev_waypoint[(size_t)current * K + k]) ++length;
+    std::vector<int>& path = results[k].path;
+    path.resize(length);
+    std::size_t pos = length;
+    for (int current = total_points; current != 0; current = prev_waypoint[(size_t)current * K + k]) {
+      path[--pos] = current;
+    }
+    path[0] = 0;
+    results[k].total_time = dp[(size_t)total_points * K + k];
+  }
+  if (stats) stats->candidates_evaluated = pairs;
+}
+
+/**
+ * @brief Loads a route once and writes the optimal course for every
+ *        parameter set to the output file
+ *
+ * Each parameter set produces one block in the output, preceded by a line
+ * naming its parameters; the block itself has the regular solveCase text
+ * layout, with the execution time of the whole sweep.
+ *
+ * @param input_file_name  Text or binary route
+ * @param output_file_name Output file
+ * @param params           Parameter sets to solve
+ * @param stats            Optional sink for the shared (j, i) pair count
+ * @return int Status code: 0 for success, 1 for errors
+ */
+int solveSweepCase(const std::string& input_file_name, const std::string& output_file_name,
+  const std::vector<UavParameters>& params, SolveStats* stats)
+{
+  const auto start_time = std::chrono::high_resolution_clock::now();
+
+  RouteFile input_file;
+  std::string load_error;
+  if (!input_file.open(input_file_name, load_error)) {
+    std::cerr << load_error << '\n';
+    return EXIT_FAILURE;
+  }
+  std::ofstream output_file(output_file_name);
+  if (!output_file.is_open()) {
+    std::cerr << "Error opening output file: " << output_file_name << '\n';
+    return EXIT_FAILURE;
+  }
+
+  std::vector<SweepResult> results;
+  solveSweep(input_file.columns(), params, results, stats);
+
+  const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+    std::chrono::high_resolution_clock::now() - start_time);
+
+  ResultWriter writer;
+  for (size_t k = 0; k < params.size(); ++k) {
+    output_file << "Parameters: uav_speed=" << params[k].speed << " wait_time=" << params[k].wait_time << '\n';
+    writer.formatText(duration.count(), results[k].total_time, results[k].path);
+    writer.writeTo(output_file);
+  }
+  if (!output_file.good()) {
+    std::cerr << "Error writing output file: " << output_file_name << '\n';
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
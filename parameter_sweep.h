@@ -0,0 +1,30 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "delivery_uav.h"
+#include "waypoint_soa.h"
+
+/**
+ * UavParameters: one (speed, wait time) configuration of a parameter sweep.
+ */
+struct UavParameters {
+  double speed;
+  double wait_time;
+};
+
+/**
+ * SweepResult: optimal course for one parameter set.
+ * - total_time: minimal total time in seconds.
+ * - path: visited indices including start (first) and terminal (last).
+ */
+struct SweepResult {
+  double total_time = 0.0;
+  std::vector<int> path;
+};
+
+void solveSweep(const WaypointColumns& cols, const std::vector<UavParameters>& params,
+  std::vector<SweepResult>& results, SolveStats* stats = nullptr, SolveWorkspace* workspace = nullptr);
+int solveSweepCase(const std::string& input_file_name, const std::string& output_file_name,
+  const std::vector<UavParameters>& params, SolveStats* stats = nullptr);
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Rebuilds the visited index sequence [0, ..., terminal] from the
+ *        predecessor links produced by the DP.
+ *
+ * The links are walked twice: once to count the visited points, then to
+ * fill the path in place from back to front. A path vector reused across
+ * solves therefore never grows by push_back and is never reversed.
+ */
+inline void reconstructPath(const std::vector<int>& prev_waypoint, int terminal, std::vector<int>& path)
+{
+  std::size_t length = 1; // Include start point
+  for (int current = terminal; current != 0; current = prev_waypoint[current]) ++length;
+
+  path.resize(length);
+  std::size_t pos = length;
+  for (int current = terminal; current != 0; current = prev_waypoint[current]) path[--pos] = current;
+  path[0] = 0;
+}
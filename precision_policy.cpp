@@ -0,0 +1,51 @@
+#include "precision_policy.h"
+
+const char* precisionName(Precision precision)
+{
+  switch (precision) {
+  case Precision::Float: return "float";
+  case Precision::Fixed: return "fixed";
+  case Precision::Double: break;
+  }
+  return "double";
+}
+
+/**
+ * @brief Solves a route with the UAV's precision and with the double
+ *        reference and reports where the two diverge
+ *
+ * Both solves use SolverMode::Simd with the UAV's speed, wait time and SIMD
+ * level, so any difference comes from the coordinate precision alone.
+ *
+ * @param uav  UAV whose precision (see DeliveryUAV::setPrecision) is checked
+ * @param cols Columns of [start, wp1, wp2..., terminal] with penalty prefix sums
+ * @return PrecisionReport Times, path lengths and the first differing path position
+ */
+PrecisionReport verifyPrecision(const DeliveryUAV& uav, const WaypointColumns& cols)
+{
+  DeliveryUAV reduced(uav.speed(), uav.waitTime());
+  reduced.setSolverMode(SolverMode::Simd);
+  reduced.setSimdLevel(uav.simdLevel());
+  reduced.setPrecision(uav.precision());
+  DeliveryUAV reference(uav.speed(), uav.waitTime());
+  reference.setSolverMode(SolverMode::Simd);
+  reference.setSimdLevel(uav.simdLevel());
+
+  std::vector<int> path;
+  std::vector<int> reference_path;
+  PrecisionReport report;
+  report.precision = uav.precision();
+  report.time = reduced.solveRoute(cols, path);
+  report.reference_time = reference.solveRoute(cols, reference_path);
+  report.path_length = path.size();
+  report.reference_length = reference_path.size();
+
+  const std::size_t common = std::min(path.size(), reference_path.size());
+  for (std::size_t k = 0; k < common && report.first_divergence < 0; ++k) {
+    if (path[k] != reference_path[k]) report.first_divergence = (long long)k;
+  }
+  if (report.first_divergence < 0 && path.size() != reference_path.size()) {
+    report.first_divergence = (long long)common;
+  }
+  return report;
+}
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "delivery_uav.h"
+#include "simd_kernels.h"
+#include "waypoint_soa.h"
+
+/**
+ * Precision: storage and arithmetic of the waypoint coordinates in the
+ * exhaustive (simd) solver. DP values and penalties always stay double.
+ * - Double: double coordinates and distances (reference).
+ * - Float:  float coordinates and distances, half the coordinate bandwidth
+ *           and twice the vector lanes for the distance computation.
+ * - Fixed:  int32 coordinates on a power-of-two grid, exact integer squared
+ *           distances.
+ */
+enum class Precision {
+  Double,
+  Float,
+  Fixed
+};
+
+const char* precisionName(Precision precision);
+
+/**
+ * ScaledColumns: coordinates of [start, wp1..wpN, terminal] re-encoded for a
+ * precision policy: value = (coordinate - origin) * scale. Distances in the
+ * encoded space are multiplied by inv_scale to get back to route units.
+ */
+template <typename Coord>
+struct ScaledColumns {
+  AlignedVector<Coord> x;
+  AlignedVector<Coord> y;
+  double origin_x = 0.0, origin_y = 0.0;
+  double scale = 1.0, inv_scale = 1.0;
+  int count = 0;
+};
+
+/**
+ * DoublePolicy / FloatPolicy / FixedPolicy: coordinate type, encoding and
+ * distance of each Precision. Coordinates are centred on the bounding box
+ * of the route first, which keeps the float and int32 grids as fine as the
+ * extent of the route allows.
+ */
+struct DoublePolicy {
+  using Coord = double;
+  static double scaleFor(double) { return 1.0; }
+  static Coord encode(double value) { return value; }
+  static double distance(Coord xi, Coord yi, Coord xj, Coord yj)
+  {
+    const double dx = xi - xj;
+    const double dy = yi - yj;
+    return std::sqrt(dx * dx + dy * dy);
+  }
+};
+
+struct FloatPolicy {
+  using Coord = float;
+  static double scaleFor(double) { return 1.0; }
+  static Coord encode(double value) { return (float)value; }
+  static double distance(Coord xi, Coord yi, Coord xj, Coord yj)
+  {
+    const float dx = xi - xj;
+    const float dy = yi - yj;
+    return (double)std::sqrt(dx * dx + dy * dy);
+  }
+};
+
+struct FixedPolicy {
+  using Coord = std::int32_t;
+
+  // Largest power of two mapping the half extent into [-2^29, 2^29], so that
+  // coordinate differences stay within 2^30 and squared distances within int64
+  static double scaleFor(double half_extent)
+  {
+    if (!(half_extent > 0.0)) return 1.0;
+    return std::ldexp(1.0, (int)std::floor(std::log2((double)(1 << 29) / half_extent)));
+  }
+  static Coord encode(double value) { return (Coord)std::llround(value); }
+  static double distance(Coord xi, Coord yi, Coord xj, Coord yj)
+  {
+    const std::int64_t dx = (std::int64_t)xi - xj;
+    const std::int64_t dy = (std::int64_t)yi - yj;
+    return std::sqrt((double)(dx * dx + dy * dy));
+  }
+};
+
+/**
+ * @brief Re-encodes the route coordinates for Policy
+ */
+template <typename Policy>
+void encodeColumns(const WaypointColumns& cols, ScaledColumns<typename Policy::Coord>& out)
+{
+  double min_x = std::numeric_limits<double>::infinity(), max_x = -min_x;
+  double min_y = min_x, max_y = -min_x;
+  for (int i = 0; i < cols.count; ++i) {
+    min_x = std::min(min_x, cols.x[i]);
+    max_x = std::max(max_x, cols.x[i]);
+    min_y = std::min(min_y, cols.y[i]);
+    max_y = std::max(max_y, cols.y[i]);
+  }
+  out.count = cols.count;
+  out.origin_x = cols.count > 0 ? 0.5 * (min_x + max_x) : 0.0;
+  out.origin_y = cols.count > 0 ? 0.5 * (min_y + max_y) : 0.0;
+  out.scale = Policy::scaleFor(cols.count > 0 ? 0.5 * std::max(max_x - min_x, max_y - min_y) : 0.0);
+  out.inv_scale = 1.0 / out.scale;
+  out.x.resize(cols.count);
+  out.y.resize(cols.count);
+  for (int i = 0; i < cols.count; ++i) {
+    out.x[i] = Policy::encode((cols.x[i] - out.origin_x) * out.scale);
+    out.y[i] = Policy::encode((cols.y[i] - out.origin_y) * out.scale);
+  }
+}
+
+/**
+ * @brief Scalar relaxation kernel of a precision policy
+ *
+ * Same candidate expression and ascending strict '<' scan as relaxScalar,
+ * with the distance computed by Policy and the DP accumulated in double.
+ *
+ * @param cols   Encoded coordinates
+ * @param prefix Penalty prefix sums
+ * @param dp     Final DP values for all j < i
+ */
+template <typename Policy>
+RelaxResult relaxScaled(const ScaledColumns<typename Policy::Coord>& cols, const double* prefix,
+  const double* dp, int i, int j_begin, int j_end, double speed)
+{
+  const typename Policy::Coord xi = cols.x[i];
+  const typename Policy::Coord yi = cols.y[i];
+  const double penalties_before_i = prefix[i - 1];
+
+  RelaxResult best{ std::numeric_limits<double>::max(), -1 };
+  for (int j = j_begin; j < j_end; ++j) {
+    const double distance = Policy::distance(xi, yi, cols.x[j], cols.y[j]) * cols.inv_scale;
+    const double time_candidate = dp[j] + distance / speed + (penalties_before_i - prefix[j]);
+    if (time_candidate < best.min_time) {
+      best.min_time = time_candidate;
+      best.best_prev = j;
+    }
+  }
+  return best;
+}
+
+/**
+ * ScaledRelaxKernel: relaxation kernel over encoded coordinates.
+ */
+template <typename Coord>
+using ScaledRelaxKernel = RelaxResult (*)(const ScaledColumns<Coord>& cols, const double* prefix,
+  const double* dp, int i, int j_begin, int j_end, double speed);
+
+ScaledRelaxKernel<float> floatRelaxKernelFor(SimdLevel level);
+
+/**
+ * PrecisionReport: divergence of a reduced-precision solve from the double
+ * reference on the same route.
+ * - time / reference_time: minimum times of both solves.
+ * - path_length / reference_length: visited points of both paths.
+ * - first_divergence: first position where the paths differ (-1 if identical).
+ */
+struct PrecisionReport {
+  Precision precision = Precision::Double;
+  double time = 0.0;
+  double reference_time = 0.0;
+  std::size_t path_length = 0;
+  std::size_t reference_length = 0;
+  long long first_divergence = -1;
+};
+
+PrecisionReport verifyPrecision(const DeliveryUAV& uav, const WaypointColumns& cols);
@@ -0,0 +1,148 @@
+#include "result_cache.h"
+#include <chrono>
+#include <cstring>
+
+namespace {
+
+constexpr std::uint64_t kPrime1 = 0x9E3779B185EBCA87ull;
+constexpr std::uint64_t kPrime2 = 0xC2B2AE3D27D4EB4Full;
+// Bookkeeping charged per entry on top of its path (list node, index slot)
+constexpr std::size_t kEntryOverhead = 128;
+
+inline std::uint64_t rotl(std::uint64_t value, int bits)
+{
+  return (value << bits) | (value >> (64 - bits));
+}
+
+inline std::uint64_t readWord(const unsigned char* bytes)
+{
+  std::uint64_t word;
+  std::memcpy(&word, bytes, sizeof(word));
+  return word;
+}
+
+inline std::uint64_t round(std::uint64_t lane, std::uint64_t word)
+{
+  return rotl(lane + word * kPrime2, 31) * kPrime1;
+}
+
+} // namespace
+
+
+/**
+ * @brief Fast non-cryptographic 64-bit hash of a byte range
+ *
+ * Four independent multiply-rotate lanes over 32-byte stripes (the round of
+ * xxHash64), so the loop runs at memory speed rather than at the latency of
+ * one multiply chain, followed by the tail bytes and a final avalanche.
+ */
+std::uint64_t hashRouteBytes(const void* data, std::size_t size)
+{
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  std::uint64_t lane[4] = { kPrime1 + kPrime2, kPrime2, 0, 0 - kPrime1 };
+  std::size_t k = 0;
+  for (; k + 32 <= size; k += 32) {
+    for (int l = 0; l < 4; ++l) lane[l] = round(lane[l], readWord(bytes + k + 8 * l));
+  }
+  std::uint64_t hash = rotl(lane[0], 1) + rotl(lane[1], 7) + rotl(lane[2], 12) + rotl(lane[3], 18) + size;
+  for (; k + 8 <= size; k += 8) hash = rotl(hash ^ round(0, readWord(bytes + k)), 27) * kPrime1 + kPrime2;
+  for (; k < size; ++k) hash = rotl(hash ^ (bytes[k] * kPrime1), 11) * kPrime2;
+
+  hash ^= hash >> 33;
+  hash *= kPrime2;
+  hash ^= hash >> 29;
+  hash *= kPrime1;
+  hash ^= hash >> 32;
+  return hash;
+}
+
+
+ResultCache::ResultCache(std::size_t capacity_bytes)
+  : capacity_(capacity_bytes)
+{
+}
+
+std::size_t ResultCache::entryBytes(std::size_t route_bytes, const std::vector<int>& path)
+{
+  return kEntryOverhead + route_bytes + path.size() * sizeof(int);
+}
+
+/**
+ * @brief Looks up the result of a route and marks it most recently used
+ *
+ * An entry with an equal key is a hit only if its stored bytes equal
+ * `data`, so a collision of the 64-bit hash counts as a miss.
+ *
+ * @param data, size Raw bytes of the route
+ * @param params     UAV configuration of the solve
+ * @param key        Receives the key, for store() after a miss
+ * @param total_time Receives the stored time on a hit
+ * @param path       Receives the stored path on a hit
+ * @return bool True on a hit
+ */
+bool ResultCache::find(const void* data, std::size_t size, const ResultCacheParams& params, ResultCacheKey& key,
+  double& total_time, std::vector<int>& path)
+{
+  const auto start = std::chrono::steady_clock::now();
+  key.content = hashRouteBytes(data, size);
+  key.size = size;
+  key.params = params;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = index_.find(key);
+  const bool hit = it != index_.end() &&
+    (size == 0 || std::memcmp(it->second->route.data(), data, size) == 0);
+  if (hit) {
+    entries_.splice(entries_.begin(), entries_, it->second);
+    total_time = it->second->total_time;
+    path = it->second->path;
+  }
+  ++stats_.lookups;
+  stats_.hits += hit;
+  stats_.lookup_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now() - start).count();
+  return hit;
+}
+
+/**
+ * @brief Stores a solved route, evicting least recently used entries while
+ *        the cache is over its capacity (a result larger than the whole
+ *        capacity is not stored)
+ *
+ * @param key        Key returned by the missed find()
+ * @param data, size The route bytes passed to find(), copied into the entry
+ * @param total_time Solved time
+ * @param path       Solved path
+ */
+void ResultCache::store(const ResultCacheKey& key, const void* data, std::size_t size, double total_time,
+  const std::vector<int>& path)
+{
+  const std::size_t bytes = entryBytes(size, path);
+  if (bytes > capacity_) return;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = index_.find(key);
+  if (it != index_.end()) {  // solved concurrently by another thread, or a colliding route
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return;
+  }
+  while (!entries_.empty() && stats_.bytes + bytes > capacity_) {
+    stats_.bytes -= entryBytes(entries_.back().route.size(), entries_.back().path);
+    index_.erase(entries_.back().key);
+    entries_.pop_back();
+    ++stats_.evictions;
+  }
+  const unsigned char* route = static_cast<const unsigned char*>(data);
+  entries_.push_front(Entry{ key, std::vector<unsigned char>(route, route + size), total_time, path });
+  index_.emplace(key, entries_.begin());
+  stats_.bytes += bytes;
+  stats_.entries = entries_.size();
+}
+
+ResultCacheStats ResultCache::stats() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  ResultCacheStats result = stats_;
+  result.entries = entries_.size();
+  return result;
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * ResultCacheParams: UAV configuration a cached result depends on; every
+ * field takes part in the key comparison (see DeliveryUAV::cacheParams).
+ * - speed, wait_time: the UAV parameters.
+ * - solver, max_skip, precision: solver settings that change time or path.
+ * - cost_model: content hash of the cost model (0 = Euclidean).
+ */
+struct ResultCacheParams {
+  double speed = 0.0;
+  double wait_time = 0.0;
+  int solver = 0;
+  int max_skip = 0;
+  int precision = 0;
+  std::uint64_t cost_model = 0;
+
+  bool operator==(const ResultCacheParams& other) const
+  {
+    return speed == other.speed && wait_time == other.wait_time && solver == other.solver &&
+      max_skip == other.max_skip && precision == other.precision && cost_model == other.cost_model;
+  }
+};
+
+/**
+ * ResultCacheKey: content hash and length of the route bytes together with
+ * the parameters they were solved for. Equal keys only make a candidate: the
+ * 64-bit hash can collide, so a hit also compares the stored bytes.
+ */
+struct ResultCacheKey {
+  std::uint64_t content = 0;
+  std::uint64_t size = 0;
+  ResultCacheParams params;
+
+  bool operator==(const ResultCacheKey& other) const
+  {
+    return content == other.content && size == other.size && params == other.params;
+  }
+};
+
+/**
+ * ResultCacheStats: counters of a ResultCache.
+ * - lookups / hits: find() calls and how many returned a stored result.
+ * - lookup_ns: total time of all find() calls, hashing included.
+ * - entries / bytes: current content; evictions: entries dropped by the cap.
+ */
+struct ResultCacheStats {
+  long long lookups = 0;
+  long long hits = 0;
+  long long lookup_ns = 0;
+  long long evictions = 0;
+  std::size_t entries = 0;
+  std::size_t bytes = 0;
+
+  double hitRate() const { return lookups ? (double)hits / lookups : 0.0; }
+  double meanLookupUs() const { return lookups ? lookup_ns / 1000.0 / lookups : 0.0; }
+};
+
+std::uint64_t hashRouteBytes(const void* data, std::size_t size);
+
+/**
+ * ResultCache: in-memory LRU cache of solved routes, shared by any number of
+ * threads and DeliveryUAV instances.
+ *
+ * Routes are looked up by a 64-bit hash of their raw bytes (text or binary
+ * file, or service payload), their length and the UAV parameters, so a
+ * repeated route is answered without parsing or DP. Every entry keeps a copy
+ * of its route bytes, which a hit compares with the queried bytes: a hash
+ * collision is a miss, never another route's answer. Entries are charged
+ * their route bytes and path plus a fixed overhead; once the total exceeds
+ * the capacity, the least recently used entries are evicted.
+ */
+class ResultCache {
+public:
+  explicit ResultCache(std::size_t capacity_bytes);
+
+  ResultCache(const ResultCache&) = delete;
+  ResultCache& operator=(const ResultCache&) = delete;
+
+  bool find(const void* data, std::size_t size, const ResultCacheParams& params, ResultCacheKey& key,
+    double& total_time, std::vector<int>& path);
+  void store(const ResultCacheKey& key, const void* data, std::size_t size, double total_time,
+    const std::vector<int>& path);
+  ResultCacheStats stats() const;
+  std::size_t capacity() const { return capacity_; }
+
+private:
+  struct Entry {
+    ResultCacheKey key;
+    std::vector<unsigned char> route;  // bytes the key was computed from
+    double total_time;
+    std::vector<int> path;
+  };
+  struct KeyHash {
+    std::size_t operator()(const ResultCacheKey& key) const { return (std::size_t)key.content; }
+  };
+
+  static std::size_t entryBytes(std::size_t route_bytes, const std::vector<int>& path);
+
+  std::size_t capacity_;
+  mutable std::mutex mutex_;
+  std::list<Entry> entries_;  // most recently used first
+  std::unordered_map<ResultCacheKey, std::list<Entry>::iterator, KeyHash> index_;
+  ResultCacheStats stats_;
+};
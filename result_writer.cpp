@@ -0,0 +1,200 @@
+#include "result_writer.h"
+#include <charconv>
+#include <cstring>
+
+namespace {
+
+constexpr char kBinaryResultMagic[4] = { 'U', 'A', 'V', 'S' };
+constexpr std::uint64_t kBinaryResultVersion = 1;
+
+// Longest text produced per path index: "-2147483648 \n"
+constexpr std::size_t kMaxIndexChars = 13;
+// Longest long long, and longest double in fixed notation with 3 decimals
+constexpr std::size_t kMaxIntegerChars = 20;
+constexpr std::size_t kMaxFixedChars = 320;
+
+template <std::size_t N>
+constexpr std::size_t literalLength(const char (&)[N]) { return N - 1; }
+
+} // namespace
+
+
+/**
+ * @brief Ensures room for `bytes` more bytes and returns the write position
+ */
+char* ResultWriter::reserve(std::size_t bytes)
+{
+  if (buffer_.size() < size_ + bytes) buffer_.resize(size_ + bytes);
+  return buffer_.data() + size_;
+}
+
+void ResultWriter::append(const char* text, std::size_t length)
+{
+  std::memcpy(reserve(length), text, length);
+  size_ += length;
+}
+
+void ResultWriter::appendVarint(std::uint64_t value)
+{
+  char* out = reserve(10);
+  std::size_t length = 0;
+  while (value >= 0x80) {
+    out[length++] = (char)((value & 0x7f) | 0x80);
+    value >>= 7;
+  }
+  out[length++] = (char)value;
+  size_ += length;
+}
+
+/**
+ * @brief Formats the text report, byte-for-byte identical to the stream
+ *        output used so far:
+ *
+ *   Execution Time: <ms> ms
+ *   Minimum UAV time: <time, fixed, 3 decimals>
+ *   Optimal waypoint indicies: 
+ *   <index> 
+ *   ...
+ *
+ * @param execution_ms Wall time of the solve in milliseconds
+ * @param total_time   Minimal total time of the course
+ * @param path         Visited indices including start (first) and terminal (last)
+ */
+void ResultWriter::formatText(long long execution_ms, double total_time, const std::vector<int>& path)
+{
+  static const char kExecution[] = "Execution Time: ";
+  static const char kMs[] = " ms\nMinimum UAV time: ";
+  static const char kIndices[] = "\nOptimal waypoint indicies: \n";
+
+  size_ = 0;
+  const std::size_t visited = path.size() >= 2 ? path.size() - 2 : 0;
+  reserve(128 + kMaxIntegerChars + kMaxFixedChars + visited * kMaxIndexChars);
+
+  append(kExecution, literalLength(kExecution));
+  char* out = reserve(kMaxIntegerChars);
+  size_ = std::to_chars(out, out + kMaxIntegerChars, execution_ms).ptr - buffer_.data();
+
+  append(kMs, literalLength(kMs));
+  out = reserve(kMaxFixedChars);
+  size_ = std::to_chars(out, out + kMaxFixedChars, total_time, std::chars_format::fixed, 3).ptr - buffer_.data();
+
+  append(kIndices, literalLength(kIndices));
+  out = reserve(visited * kMaxIndexChars);
+  for (std::size_t idx = 1; idx + 1 < path.size(); ++idx) {
+    out = std::to_chars(out, out + kMaxIndexChars, path[idx]).ptr;
+    *out++ = ' ';
+    *out++ = '\n';
+  }
+  size_ = out - buffer_.data();
+}
+
+/**
+ * @brief Appends an alternative route to a text report (top-K output):
+ *
+ *   Alternative <rank> UAV time: <time, fixed, 3 decimals>
+ *   Alternative <rank> waypoint indicies: 
+ *   <index> 
+ *   ...
+ *
+ * @param rank       1-based rank of the route (2 = second best)
+ * @param total_time Total time of the route
+ * @param path       Visited indices including start (first) and terminal (last)
+ */
+void ResultWriter::appendAlternative(int rank, double total_time, const std::vector<int>& path)
+{
+  static const char kAlternative[] = "Alternative ";
+  appendNumberedRoute(kAlternative, literalLength(kAlternative), rank, total_time, path);
+}
+
+/**
+ * @brief Appends the route of one drone to a text report (fleet output):
+ *
+ *   Drone <d> UAV time: <time, fixed, 3 decimals>
+ *   Drone <d> waypoint indicies: 
+ *   <index> 
+ *   ...
+ *
+ * @param drone      1-based drone number, in waypoint order
+ * @param total_time Total time of the drone
+ * @param path       Visited indices including start (first) and terminal (last)
+ */
+void ResultWriter::appendDrone(int drone, double total_time, const std::vector<int>& path)
+{
+  static const char kDrone[] = "Drone ";
+  appendNumberedRoute(kDrone, literalLength(kDrone), drone, total_time, path);
+}
+
+/**
+ * @brief Shared layout of appendAlternative() and appendDrone()
+ */
+void ResultWriter::appendNumberedRoute(const char* label, std::size_t label_length, int number, double total_time,
+  const std::vector<int>& path)
+{
+  static const char kTime[] = " UAV time: ";
+  static const char kIndices[] = " waypoint indicies: \n";
+
+  const std::size_t visited = path.size() >= 2 ? path.size() - 2 : 0;
+  reserve(128 + 2 * (label_length + kMaxIntegerChars) + kMaxFixedChars + visited * kMaxIndexChars);
+
+  append(label, label_length);
+  char* out = reserve(kMaxIntegerChars);
+  size_ = std::to_chars(out, out + kMaxIntegerChars, number).ptr - buffer_.data();
+  append(kTime, literalLength(kTime));
+  out = reserve(kMaxFixedChars);
+  size_ = std::to_chars(out, out + kMaxFixedChars, total_time, std::chars_format::fixed, 3).ptr - buffer_.data();
+  append("\n", 1);
+
+  append(label, label_length);
+  out = reserve(kMaxIntegerChars);
+  size_ = std::to_chars(out, out + kMaxIntegerChars, number).ptr - buffer_.data();
+  append(kIndices, literalLength(kIndices));
+  out = reserve(visited * kMaxIndexChars);
+  for (std::size_t idx = 1; idx + 1 < path.size(); ++idx) {
+    out = std::to_chars(out, out + kMaxIndexChars, path[idx]).ptr;
+    *out++ = ' ';
+    *out++ = '\n';
+  }
+  size_ = out - buffer_.data();
+}
+
+/**
+ * @brief Formats the compact binary record:
+ *
+ *   "UAVS"                 4-byte magic
+ *   varint version         currently 1
+ *   varint execution_ms
+ *   float64 total_time     native little-endian
+ *   varint count           number of visited waypoints (start/terminal excluded)
+ *   count varints          first index, then gaps to the previous index (>= 1)
+ *
+ * Visited indices are strictly increasing, so most gaps take a single byte.
+ */
+void ResultWriter::formatBinary(long long execution_ms, double total_time, const std::vector<int>& path)
+{
+  size_ = 0;
+  const std::size_t visited = path.size() >= 2 ? path.size() - 2 : 0;
+  reserve(64 + visited * 5);
+
+  append(kBinaryResultMagic, sizeof(kBinaryResultMagic));
+  appendVarint(kBinaryResultVersion);
+  appendVarint(execution_ms < 0 ? 0 : (std::uint64_t)execution_ms);
+  append(reinterpret_cast<const char*>(&total_time), sizeof(total_time));
+  appendVarint(visited);
+
+  int previous = 0;
+  for (std::size_t idx = 1; idx + 1 < path.size(); ++idx) {
+    appendVarint((std::uint64_t)(path[idx] - previous));
+    previous = path[idx];
+  }
+}
+
+/**
+ * @brief Writes the formatted buffer with a single stream write
+ *
+ * @return bool True if the stream accepted all bytes
+ */
+bool ResultWriter::writeTo(std::ostream& out) const
+{
+  out.write(buffer_.data(), (std::streamsize)size_);
+  return out.good();
+}
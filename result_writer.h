@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+/**
+ * OutputFormat: layout of the solution written by DeliveryUAV::solveCase.
+ * - Text:   human-readable report (execution time, minimum time, indices).
+ * - Binary: compact record for downstream tools, see ResultWriter::formatBinary.
+ */
+enum class OutputFormat {
+  Text,
+  Binary
+};
+
+/**
+ * ResultWriter: formats a solution into a reusable buffer and writes it with
+ * a single call. The buffer only grows, so a writer reused across cases stops
+ * allocating once it has seen the longest path.
+ */
+class ResultWriter {
+public:
+  void formatText(long long execution_ms, double total_time, const std::vector<int>& path);
+  void formatBinary(long long execution_ms, double total_time, const std::vector<int>& path);
+  void appendAlternative(int rank, double total_time, const std::vector<int>& path);
+  void appendDrone(int drone, double total_time, const std::vector<int>& path);
+  bool writeTo(std::ostream& out) const;
+
+  const char* data() const { return buffer_.data(); }
+  std::size_t size() const { return size_; }
+
+private:
+  char* reserve(std::size_t bytes);
+  void append(const char* text, std::size_t length);
+  void appendVarint(std::uint64_t value);
+  void appendNumberedRoute(const char* label, std::size_t label_length, int number, double total_time,
+    const std::vector<int>& path);
+
+  std::vector<char> buffer_;
+  std::size_t size_ = 0;
+};
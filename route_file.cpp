@@ -0,0 +1,65 @@
+#include "route_file.h"
+#include "waypoint_loader.h"
+
+/**
+ * @brief Opens a text or binary route
+ *
+ * The format is recognized by the binary magic bytes. Text files follow the
+ * layout documented in parseWaypointText() and are parsed straight into SoA
+ * columns, including the penalty prefix sums.
+ *
+ * @param path  Route file
+ * @param error Receives a complete, printable message on failure
+ * @return bool True if the route is ready for solving
+ */
+bool RouteFile::open(const std::string& path, std::string& error)
+{
+  return map(path, error) && load(path, error);
+}
+
+/**
+ * @brief First half of open(): maps the file without interpreting it
+ */
+bool RouteFile::map(const std::string& path, std::string& error)
+{
+  close();
+  if (!file_.open(path)) {
+    error = "Error opening input file: " + path;
+    return false;
+  }
+  bytes_read_ = file_.size();
+  return true;
+}
+
+/**
+ * @brief Second half of open(): recognizes and loads the mapped route
+ */
+bool RouteFile::load(const std::string& path, std::string& error)
+{
+  std::string detail;
+  if (isBinaryRoute(file_.data(), file_.size())) {
+    if (!binary_.open(file_.data(), file_.size(), detail)) {
+      error = "Invalid binary route " + path + ": " + detail;
+      return false;
+    }
+    columns_ = binary_.columns();
+    is_binary_ = true;
+    return true;
+  }
+
+  if (!parseWaypointText(file_.data(), file_.data() + file_.size(), soa_, detail)) {
+    error = "Invalid input format in " + path + ", " + detail;
+    return false;
+  }
+  file_.close();  // text input is fully copied into the SoA columns
+  columns_ = soa_.columns();
+  return true;
+}
+
+void RouteFile::close()
+{
+  file_.close();
+  columns_ = WaypointColumns();
+  is_binary_ = false;
+  bytes_read_ = 0;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <string>
+
+#include "binary_route.h"
+#include "mapped_file.h"
+#include "waypoint_soa.h"
+
+/**
+ * RouteFile: a route loaded from disk in either supported format.
+ *
+ * Binary routes are used in place from the mapping; text files are parsed
+ * into an owned WaypointSoA. columns() stays valid until the RouteFile is
+ * closed or destroyed. open() is map() followed by load(); in between, the
+ * raw bytes can be inspected, e.g. hashed for the result cache.
+ */
+class RouteFile {
+public:
+  bool open(const std::string& path, std::string& error);
+  bool map(const std::string& path, std::string& error);
+  bool load(const std::string& path, std::string& error);
+  void close();
+
+  // Raw bytes of a mapped, not yet loaded text route (or of a binary route)
+  const char* data() const { return file_.data(); }
+  std::size_t size() const { return file_.size(); }
+  const WaypointColumns& columns() const { return columns_; }
+  bool isBinary() const { return is_binary_; }
+  std::size_t bytesRead() const { return bytes_read_; }
+
+private:
+  MappedFile file_;
+  WaypointSoA soa_;
+  BinaryRouteView binary_;
+  WaypointColumns columns_;
+  bool is_binary_ = false;
+  std::size_t bytes_read_ = 0;
+};
@@ -0,0 +1,167 @@
+#include "route_generator.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+
+namespace {
+
+/**
+ * SplitMix64: small seeded generator. Used instead of <random> engines and
+ * distributions, whose output differs between standard libraries, so that a
+ * seed names the same route everywhere.
+ */
+struct SplitMix64 {
+  std::uint64_t state;
+
+  std::uint64_t next() {
+    std::uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+  }
+
+  // Uniform in [lo, hi)
+  double uniform(double lo, double hi) {
+    return lo + (hi - lo) * (double)(next() >> 11) * (1.0 / 9007199254740992.0);
+  }
+};
+
+// Side of the square area for uniform/clustered routes, chosen so the mean
+// spacing between consecutive waypoints stays comparable across sizes.
+double areaSide(int waypoints)
+{
+  return 100.0 * std::sqrt(std::max(1, waypoints) / 100.0) + 100.0;
+}
+
+} // namespace
+
+
+/**
+ * @brief Generates a seeded synthetic route
+ *
+ * Start and terminal are the corners (0, 0) and (side, side) for the area
+ * shapes, and the ends of the corridor for RouteShape::Corridor.
+ *
+ * @param spec Shape, penalty profile, number of waypoints and seed
+ * @return WaypointSoA Route in solver layout, including penalty prefix sums
+ */
+WaypointSoA generateRoute(const RouteSpec& spec)
+{
+  SplitMix64 rng{ spec.seed * 0x2545f4914f6cdd1dULL + (std::uint64_t)spec.shape * 131 + (std::uint64_t)spec.penalties };
+  const int n = std::max(0, spec.waypoints);
+  const size_t count = (size_t)n + 2;
+
+  WaypointSoA soa;
+  soa.x.resize(count);
+  soa.y.resize(count);
+  soa.penalty.assign(count, 0.0);
+  soa.prefix.assign(count, 0.0);
+
+  const double side = areaSide(n);
+  double term_x = side, term_y = side;
+
+  switch (spec.shape) {
+  case RouteShape::Uniform:
+    for (int i = 1; i <= n; ++i) {
+      soa.x[i] = rng.uniform(0.0, side);
+      soa.y[i] = rng.uniform(0.0, side);
+    }
+    break;
+  case RouteShape::Clustered: {
+    const int per_cluster = 50;
+    double cx = 0.0, cy = 0.0;
+    for (int i = 1; i <= n; ++i) {
+      if ((i - 1) % per_cluster == 0) {
+        cx = rng.uniform(0.05 * side, 0.95 * side);
+        cy = rng.uniform(0.05 * side, 0.95 * side);
+      }
+      // Sum of uniforms: cheap, bell-shaped spread around the cluster centre
+      const double spread = 0.01 * side;
+      soa.x[i] = cx + spread * (rng.uniform(-1, 1) + rng.uniform(-1, 1) + rng.uniform(-1, 1));
+      soa.y[i] = cy + spread * (rng.uniform(-1, 1) + rng.uniform(-1, 1) + rng.uniform(-1, 1));
+    }
+    break;
+  }
+  case RouteShape::Corridor: {
+    const double spacing = 10.0;
+    const double width = 20.0;
+    for (int i = 1; i <= n; ++i) {
+      soa.x[i] = i * spacing + rng.uniform(-0.4, 0.4) * spacing;
+      soa.y[i] = rng.uniform(-0.5, 0.5) * width;
+    }
+    term_x = (n + 1) * spacing;
+    term_y = 0.0;
+    break;
+  }
+  }
+
+  const double lo = (spec.penalties == PenaltyProfile::Light) ? 0.0 : 50.0;
+  const double hi = (spec.penalties == PenaltyProfile::Light) ? 5.0 : 150.0;
+  for (int i = 1; i <= n; ++i) {
+    soa.penalty[i] = std::round(rng.uniform(lo, hi));
+    soa.prefix[i] = soa.prefix[i - 1] + soa.penalty[i];
+  }
+
+  soa.x[0] = 0.0;
+  soa.y[0] = 0.0;
+  soa.x[n + 1] = term_x;
+  soa.y[n + 1] = term_y;
+  soa.prefix[n + 1] = soa.prefix[n];
+  return soa;
+}
+
+/**
+ * @brief Writes a route in the text input format read by solveCase
+ *
+ * @param cols [start, wp1..wpN, terminal] columns
+ * @param path Output file
+ * @return bool True on success
+ */
+bool writeWaypointText(const WaypointColumns& cols, const std::string& path)
+{
+  std::ofstream out(path);
+  if (!out.is_open()) return false;
+
+  const int n = cols.count - 2;
+  out << std::setprecision(17);
+  out << cols.x[0] << ' ' << cols.y[0] << '\n';
+  out << cols.x[n + 1] << ' ' << cols.y[n + 1] << '\n';
+  out << n << '\n';
+  for (int i = 1; i <= n; ++i) {
+    out << cols.x[i] << ' ' << cols.y[i] << ' ' << cols.penalty[i] << '\n';
+  }
+  return out.good();
+}
+
+const char* routeShapeName(RouteShape shape)
+{
+  switch (shape) {
+  case RouteShape::Clustered: return "clustered";
+  case RouteShape::Corridor:  return "corridor";
+  case RouteShape::Uniform:   break;
+  }
+  return "uniform";
+}
+
+const char* penaltyProfileName(PenaltyProfile profile)
+{
+  return profile == PenaltyProfile::Light ? "light" : "heavy";
+}
+
+bool parseRouteShape(const std::string& name, RouteShape& shape)
+{
+  if (name == "uniform") shape = RouteShape::Uniform;
+  else if (name == "clustered") shape = RouteShape::Clustered;
+  else if (name == "corridor") shape = RouteShape::Corridor;
+  else return false;
+  return true;
+}
+
+bool parsePenaltyProfile(const std::string& name, PenaltyProfile& profile)
+{
+  if (name == "light") profile = PenaltyProfile::Light;
+  else if (name == "heavy") profile = PenaltyProfile::Heavy;
+  else return false;
+  return true;
+}
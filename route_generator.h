@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "waypoint_soa.h"
+
+/**
+ * RouteShape: geometry of a synthetic route.
+ * - Uniform:   waypoints spread uniformly over a square area.
+ * - Clustered: waypoints grouped in dense clusters visited one after another.
+ * - Corridor:  long, thin survey corridor advancing along the x axis.
+ */
+enum class RouteShape {
+  Uniform,
+  Clustered,
+  Corridor
+};
+
+/**
+ * PenaltyProfile: distribution of skip penalties.
+ * - Light: penalties in [0, 5] s, often cheaper than stopping.
+ * - Heavy: penalties in [50, 150] s, skipping rarely pays off.
+ */
+enum class PenaltyProfile {
+  Light,
+  Heavy
+};
+
+/**
+ * RouteSpec: parameters of a synthetic route; the same spec and seed always
+ * produce the same route on every platform.
+ */
+struct RouteSpec {
+  RouteShape shape = RouteShape::Uniform;
+  PenaltyProfile penalties = PenaltyProfile::Heavy;
+  int waypoints = 1000;
+  std::uint64_t seed = 1;
+};
+
+WaypointSoA generateRoute(const RouteSpec& spec);
+bool writeWaypointText(const WaypointColumns& cols, const std::string& path);
+
+const char* routeShapeName(RouteShape shape);
+const char* penaltyProfileName(PenaltyProfile profile);
+bool parseRouteShape(const std::string& name, RouteShape& shape);
+bool parsePenaltyProfile(const std::string& name, PenaltyProfile& profile);
@@ -0,0 +1,205 @@
+#include "route_session.h"
+#include "cost_model.h"
+#include "path_utils.h"
+#include "simd_kernels.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+/**
+ * @brief Creates a session for a copy of `route`, solved lazily on the
+ *        first call to solve()
+ *
+ * @param uav   Supplies speed, wait time, solver mode and SIMD level
+ * @param route Columns of [start, wp1..wpN, terminal] (prefix is rebuilt)
+ */
+RouteSession::RouteSession(const DeliveryUAV& uav, const WaypointColumns& route)
+  : uav_speed_(uav.speed()),
+  wait_time_(uav.waitTime()),
+  pruned_(uav.solverMode() == SolverMode::Pruned),
+  simd_level_(uav.simdLevel())
+{
+  const size_t count = (size_t)route.count;
+  route_.x.assign(route.x, route.x + count);
+  route_.y.assign(route.y, route.y + count);
+  route_.penalty.assign(route.penalty, route.penalty + count);
+  route_.prefix.assign(count, 0.0);
+  dp_.assign(count, 0.0);
+  prev_waypoint_.assign(count, -1);
+  if (pruned_) floor_.assign(count, 0.0);
+}
+
+WayPoint RouteSession::waypoint(int k) const
+{
+  return WayPoint(route_.x[k], route_.y[k], route_.penalty[k]);
+}
+
+void RouteSession::markDirty(int k)
+{
+  dirty_from_ = std::min(dirty_from_, k);
+}
+
+void RouteSession::insertRow(int k)
+{
+  route_.x.insert(route_.x.begin() + k, 0.0);
+  route_.y.insert(route_.y.begin() + k, 0.0);
+  route_.penalty.insert(route_.penalty.begin() + k, 0.0);
+  route_.prefix.insert(route_.prefix.begin() + k, 0.0);
+  dp_.insert(dp_.begin() + k, 0.0);
+  prev_waypoint_.insert(prev_waypoint_.begin() + k, -1);
+  if (pruned_) floor_.insert(floor_.begin() + k, 0.0);
+}
+
+void RouteSession::eraseRow(int k)
+{
+  route_.x.erase(route_.x.begin() + k);
+  route_.y.erase(route_.y.begin() + k);
+  route_.penalty.erase(route_.penalty.begin() + k);
+  route_.prefix.erase(route_.prefix.begin() + k);
+  dp_.erase(dp_.begin() + k);
+  prev_waypoint_.erase(prev_waypoint_.begin() + k);
+  if (pruned_) floor_.erase(floor_.begin() + k);
+}
+
+/**
+ * @brief Inserts a waypoint so that it becomes waypoint k; the former
+ *        waypoints k..N move to k+1..N+1
+ *
+ * @param k        New index, 1..N+1 (N + 1 appends before the terminal point)
+ * @param waypoint Coordinates and skip penalty
+ * @throws std::out_of_range for an invalid index
+ */
+void RouteSession::insertWaypoint(int k, const WayPoint& waypoint)
+{
+  if (k < 1 || k > waypointCount() + 1) {
+    throw std::out_of_range("RouteSession::insertWaypoint: index " + std::to_string(k) + " out of range");
+  }
+  insertRow(k);
+  route_.x[k] = waypoint.x;
+  route_.y[k] = waypoint.y;
+  route_.penalty[k] = waypoint.penalty;
+  markDirty(k);
+}
+
+/**
+ * @brief Removes waypoint k; the waypoints behind it move one index down
+ *
+ * @param k Index of the waypoint, 1..N
+ * @throws std::out_of_range for an invalid index
+ */
+void RouteSession::removeWaypoint(int k)
+{
+  if (k < 1 || k > waypointCount()) {
+    throw std::out_of_range("RouteSession::removeWaypoint: index " + std::to_string(k) + " out of range");
+  }
+  eraseRow(k);
+  markDirty(k);
+}
+
+/**
+ * @brief Replaces coordinates and penalty of waypoint k
+ *
+ * @param k        Index of the waypoint, 1..N
+ * @param waypoint New coordinates and skip penalty
+ * @throws std::out_of_range for an invalid index
+ */
+void RouteSession::updateWaypoint(int k, const WayPoint& waypoint)
+{
+  if (k < 1 || k > waypointCount()) {
+    throw std::out_of_range("RouteSession::updateWaypoint: index " + std::to_string(k) + " out of range");
+  }
+  route_.x[k] = waypoint.x;
+  route_.y[k] = waypoint.y;
+  route_.penalty[k] = waypoint.penalty;
+  markDirty(k);
+}
+
+/**
+ * @brief Changes the skip penalty of waypoint k
+ *
+ * dp[k] itself only depends on the penalties before k, so rows from k + 1 on
+ * are recomputed.
+ *
+ * @param k       Index of the waypoint, 1..N
+ * @param penalty New skip penalty
+ * @throws std::out_of_range for an invalid index
+ */
+void RouteSession::setPenalty(int k, double penalty)
+{
+  if (k < 1 || k > waypointCount()) {
+    throw std::out_of_range("RouteSession::setPenalty: index " + std::to_string(k) + " out of range");
+  }
+  route_.penalty[k] = penalty;
+  if (dirty_from_ > k) {
+    // dp[k] stays valid; refresh the state of row k that includes penalty k
+    route_.prefix[k] = route_.prefix[k - 1] + penalty;
+    if (pruned_) floor_[k] = std::min(floor_[k - 1], dp_[k] - route_.prefix[k]);
+  }
+  markDirty(k + 1);
+}
+
+/**
+ * @brief Brings the DP up to date and returns the optimal course
+ *
+ * Rows below dirtyFrom() are reused. From there on the prefix sums are
+ * rebuilt (the terminal point carries no penalty) and every row is relaxed
+ * again, which for an edit near the end of the route costs a few rows
+ * instead of a full solve.
+ *
+ * @param path  Visited indices including start (first) and terminal (last)
+ * @param stats Optional sink; counts the candidates of the recomputed rows
+ * @return double Minimal total time in seconds to complete the course
+ */
+double RouteSession::solve(std::vector<int>& path, SolveStats* stats)
+{
+  const int total_points = (int)route_.x.size() - 1;
+  SolveStats solve_stats;
+
+  if (dirty_from_ <= total_points) {
+    const int first = dirty_from_;
+    for (int i = first; i < total_points; ++i) {
+      route_.prefix[i] = route_.prefix[i - 1] + route_.penalty[i];
+    }
+    route_.prefix[total_points] = route_.prefix[total_points - 1];  // no terminal penalty
+
+    const WaypointColumns cols = route_.columns();
+    const RelaxKernel relax = relaxKernelFor(simd_level_);
+    const EuclideanCost cost(uav_speed_);
+    for (int i = first; i <= total_points; ++i) {
+      if (pruned_) {
+        // Same scan as DeliveryUAV::solvePruned
+        double min_time = std::numeric_limits<double>::max();
+        int bestPrev = -1;
+        const double penalties_before_i = cols.prefix[i - 1];
+        for (int j = i - 1; j >= 0; --j) {
+          const double bound = floor_[j] + penalties_before_i;
+          if (bound - min_time > 1e-12 * std::fabs(min_time)) break;
+
+          const double travel = cost.travelTime(cols.x[j], cols.y[j], cols.x[i], cols.y[i], j, i, dp_[j]);
+          const double time_candidate = dp_[j] + travel + (penalties_before_i - cols.prefix[j]);
+          ++solve_stats.candidates_evaluated;
+          if (time_candidate <= min_time) {
+            min_time = time_candidate;
+            bestPrev = j;
+          }
+        }
+        dp_[i] = min_time + wait_time_;
+        prev_waypoint_[i] = bestPrev;
+        floor_[i] = std::min(floor_[i - 1], dp_[i] - cols.prefix[i]);
+      }
+      else {
+        const RelaxResult best = relax(cols, dp_.data(), i, 0, i, uav_speed_);
+        dp_[i] = best.min_time + wait_time_;
+        prev_waypoint_[i] = best.best_prev;
+        solve_stats.candidates_evaluated += i;
+      }
+    }
+    dirty_from_ = total_points + 1;
+  }
+
+  reconstructPath(prev_waypoint_, total_points, path);
+  if (stats) *stats = solve_stats;
+  return dp_[total_points];
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <vector>
+
+#include "delivery_uav.h"
+#include "waypoint_soa.h"
+
+/**
+ * RouteSession: a route kept in memory together with its DP state, so that
+ * live edits are answered without solving the whole route again.
+ *
+ * Waypoints are numbered 1..N as in the input file (0 is the start point,
+ * N + 1 the terminal point). An edit at waypoint k only marks rows k..N+1
+ * dirty; the next solve() rebuilds the penalty prefix sums and the DP from
+ * the first dirty row and reuses dp[0..k-1] as is. Several edits before a
+ * solve() cost no more than the earliest of them.
+ *
+ * The relaxation follows the UAV's solver mode when the session is created:
+ * SolverMode::Pruned uses the pruned scan, every other mode the exhaustive
+ * vector kernel of SolverMode::Simd. Results are identical to a full solve
+ * of the edited route with that solver.
+ */
+class RouteSession {
+public:
+  RouteSession(const DeliveryUAV& uav, const WaypointColumns& route);
+
+  int waypointCount() const { return (int)route_.x.size() - 2; }
+  WayPoint waypoint(int k) const;
+  int dirtyFrom() const { return dirty_from_; }
+
+  void insertWaypoint(int k, const WayPoint& waypoint);
+  void removeWaypoint(int k);
+  void updateWaypoint(int k, const WayPoint& waypoint);
+  void setPenalty(int k, double penalty);
+
+  double solve(std::vector<int>& path, SolveStats* stats = nullptr);
+
+private:
+  void markDirty(int k);
+  void insertRow(int k);
+  void eraseRow(int k);
+
+  double uav_speed_;
+  double wait_time_;
+  bool pruned_;
+  SimdLevel simd_level_;
+
+  WaypointSoA route_;             // [start, wp1..wpN, terminal]; prefix valid below dirty_from_
+  AlignedVector<double> dp_;
+  std::vector<double> floor_;     // pruning bound, SolverMode::Pruned only
+  std::vector<int> prev_waypoint_;
+  int dirty_from_ = 1;            // first row whose prefix / dp is stale
+};
@@ -0,0 +1,281 @@
+#include "delivery_uav.h"
+#include "cost_model.h"
+#include "path_utils.h"
+#include "solve_profile.h"
+#include "solve_workspace.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+constexpr RelaxResult kNoPredecessor{ std::numeric_limits<double>::max(), -1 };
+
+/**
+ * MinFenwick: Fenwick (binary indexed) tree over coordinate ranks holding
+ * the best (lowest value, then smallest index) entry of every rank prefix.
+ * The nodes live in a workspace buffer; reset() clears only touched ranks.
+ */
+class MinFenwick {
+public:
+  MinFenwick(RelaxResult* nodes, int size) : nodes_(nodes), size_(size) {}
+
+  void clear() { std::fill(nodes_, nodes_ + size_ + 1, kNoPredecessor); }
+
+  void insert(int rank, const RelaxResult& value)
+  {
+    for (int k = rank + 1; k <= size_; k += k & -k) {
+      if (isBetterRelax(value, nodes_[k])) nodes_[k] = value;
+    }
+  }
+
+  // Best entry over ranks [0, rank]; counts the visited nodes
+  RelaxResult query(int rank, long long& visited) const
+  {
+    RelaxResult best = kNoPredecessor;
+    for (int k = rank + 1; k > 0; k -= k & -k) {
+      ++visited;
+      if (isBetterRelax(nodes_[k], best)) best = nodes_[k];
+    }
+    return best;
+  }
+
+  void reset(int rank)
+  {
+    for (int k = rank + 1; k <= size_; k += k & -k) nodes_[k] = kNoPredecessor;
+  }
+
+private:
+  RelaxResult* nodes_;
+  int size_;
+};
+
+/**
+ * @brief Dense ranks of values[0..count) (equal values share a rank)
+ * @return int Number of distinct values
+ */
+int denseRanks(const double* values, int count, std::vector<int>& order, std::vector<int>& ranks)
+{
+  order.resize(count);
+  ranks.resize(count);
+  for (int k = 0; k < count; ++k) order[k] = k;
+  std::sort(order.begin(), order.end(), [&](int a, int b) { return values[a] < values[b]; });
+  int distinct = 0;
+  for (int k = 0; k < count; ++k) {
+    if (k > 0 && values[order[k]] != values[order[k - 1]]) ++distinct;
+    ranks[order[k]] = distinct;
+  }
+  return count > 0 ? distinct + 1 : 0;
+}
+
+/**
+ * @brief Positions along the line through all points, if the route is one
+ *
+ * The line runs from the start to the point farthest from it. A point counts
+ * as on the line if its distance from it is within 1e-9 of that extent.
+ */
+bool corridorPositions(const WaypointColumns& cols, std::vector<double>& positions)
+{
+  int far = 0;
+  double extent = 0.0;
+  for (int k = 1; k < cols.count; ++k) {
+    const double d = std::hypot(cols.x[k] - cols.x[0], cols.y[k] - cols.y[0]);
+    if (d > extent) {
+      extent = d;
+      far = k;
+    }
+  }
+  positions.resize(cols.count);
+  if (far == 0) {  // all points coincide
+    std::fill(positions.begin(), positions.end(), 0.0);
+    return true;
+  }
+  const double ux = (cols.x[far] - cols.x[0]) / extent;
+  const double uy = (cols.y[far] - cols.y[0]) / extent;
+  for (int k = 0; k < cols.count; ++k) {
+    const double rx = cols.x[k] - cols.x[0];
+    const double ry = cols.y[k] - cols.y[0];
+    if (std::fabs(rx * uy - ry * ux) > 1e-9 * extent) return false;
+    positions[k] = rx * ux + ry * uy;
+  }
+  return true;
+}
+
+/**
+ * CdqManhattan: divide and conquer over the point indices for the Manhattan
+ * cost. For a quadrant (sx, sy), every pair j < i with sx*x_j <= sx*x_i and
+ * sy*y_j <= sy*y_i costs ((sx*x_i + sy*y_i) - (sx*x_j + sy*y_j)) / speed.
+ * solve(l, r) finishes [l, mid] first, then relaxes all of [mid+1, r] against
+ * it in one sweep per quadrant (points sorted by x, Fenwick tree over the y
+ * ranks), then recurses into [mid+1, r].
+ */
+class CdqManhattan {
+public:
+  CdqManhattan(const WaypointColumns& cols, double inv_speed, double wait_time, SolveWorkspace& ws, long long& visited)
+    : cols_(cols), inv_speed_(inv_speed), wait_time_(wait_time), ws_(ws), visited_(visited) {}
+
+  void run()
+  {
+    const int count = cols_.count;
+    ws_.best.assign(count, kNoPredecessor);
+    ws_.keys.resize(count);
+    // y ranks (ascending); sy = -1 uses the mirrored ranks
+    y_ranks_ = denseRanks(cols_.y, count, ws_.order, ws_.ranks);
+    ws_.tree.assign(y_ranks_ + 1, kNoPredecessor);
+    solve(0, count - 1);
+  }
+
+private:
+  void finish(int i)
+  {
+    if (i == 0) ws_.dp[0] = 0.0;
+    else {
+      ws_.dp[i] = ws_.best[i].min_time + cols_.prefix[i - 1] + wait_time_;
+      ws_.prev_waypoint[i] = ws_.best[i].best_prev;
+    }
+    ws_.keys[i] = ws_.dp[i] - cols_.prefix[i];
+  }
+
+  void solve(int l, int r)
+  {
+    if (l == r) {
+      finish(l);
+      return;
+    }
+    const int mid = l + (r - l) / 2;
+    solve(l, mid);
+
+    // order[l..mid] and order[mid+1..r]: both halves by ascending x
+    int* order = ws_.order.data();
+    for (int k = l; k <= r; ++k) order[k] = k;
+    auto by_x = [&](int a, int b) { return cols_.x[a] < cols_.x[b]; };
+    std::sort(order + l, order + mid + 1, by_x);
+    std::sort(order + mid + 1, order + r + 1, by_x);
+    for (int sx : { 1, -1 }) {
+      for (int sy : { 1, -1 }) sweep(order + l, mid - l + 1, order + mid + 1, r - mid, sx, sy);
+    }
+
+    solve(mid + 1, r);
+  }
+
+  // Relaxes every right point against the left points of quadrant (sx, sy)
+  void sweep(const int* left, int left_count, const int* right, int right_count, int sx, int sy)
+  {
+    MinFenwick tree(ws_.tree.data(), y_ranks_);
+    auto rank = [&](int k) { return sy > 0 ? ws_.ranks[k] : y_ranks_ - 1 - ws_.ranks[k]; };
+    auto weight = [&](int k) { return (sx * cols_.x[k] + sy * cols_.y[k]) * inv_speed_; };
+    // sx = -1 walks both halves by descending x
+    auto at = [&](const int* half, int count, int k) { return sx > 0 ? half[k] : half[count - 1 - k]; };
+
+    int next = 0;
+    for (int k = 0; k < right_count; ++k) {
+      const int i = at(right, right_count, k);
+      while (next < left_count) {
+        const int j = at(left, left_count, next);
+        if (sx * cols_.x[j] > sx * cols_.x[i]) break;
+        tree.insert(rank(j), RelaxResult{ ws_.keys[j] - weight(j), j });
+        ++next;
+      }
+      const RelaxResult found = tree.query(rank(i), visited_);
+      if (found.best_prev < 0) continue;
+      const RelaxResult candidate{ found.min_time + weight(i), found.best_prev };
+      if (isBetterRelax(candidate, ws_.best[i])) ws_.best[i] = candidate;
+    }
+    for (int k = 0; k < next; ++k) tree.reset(rank(at(left, left_count, k)));
+  }
+
+  const WaypointColumns& cols_;
+  double inv_speed_;
+  double wait_time_;
+  SolveWorkspace& ws_;
+  long long& visited_;
+  int y_ranks_ = 0;
+};
+
+} // namespace
+
+
+/**
+ * @brief DP for transition costs that split into a term of j and a term of i
+ *
+ * With key[j] = dp[j] - prefix[j], every candidate is
+ *   key[j] + cost(j, i) + prefix[i-1]
+ * and for these costs min_j key[j] + cost(j, i) is a dominance query:
+ * - Routes on a single line (Euclidean cost): cost = |p_i - p_j| / speed for
+ *   the positions p along the line. Predecessors with p_j <= p_i contribute
+ *   key[j] - p_j / speed, the others key[j] + p_j / speed; two Fenwick trees
+ *   over the position ranks answer both halves in O(log N). O(N log N).
+ * - CostModelKind::Manhattan: |dx| + |dy| is linear within each of the four
+ *   quadrants around point i; the quadrant queries are three-dimensional
+ *   (index, x, y) and are answered by divide and conquer over the indices
+ *   (see CdqManhattan). O(N log^2 N).
+ * The trees keep the lowest value and, among equal values, the smallest j,
+ * as the scan of solve(). Times are the same as solve() up to rounding of
+ * the regrouped sums, so near-exact ties may pick another predecessor.
+ * candidates_evaluated counts the visited tree nodes.
+ *
+ * @param cols   Columns of [start, wp1, wp2..., terminal] with penalty prefix sums
+ * @param path   Output vector storing indices of visited (optimal) waypoints in order
+ * @param stats  Receives the number of tree nodes visited
+ * @param result Receives the minimal total time
+ * @return bool false if the route and cost model are not separable (a
+ *         general solver has to be used instead)
+ */
+bool DeliveryUAV::solveSeparable(
+  const WaypointColumns& cols,
+  std::vector<int>& path,
+  SolveStats& stats,
+  double& result) const
+{
+  const CostModel* cost_model = cost_model_.get();
+  const bool manhattan = cost_model && cost_model->kind == CostModelKind::Manhattan;
+  if (cost_model && !manhattan && cost_model->kind != CostModelKind::Euclidean) return false;
+
+  SolveWorkspace& ws = workspace();
+  if (!manhattan && !corridorPositions(cols, ws.keys)) return false;
+
+  const int total_points = cols.count - 1;
+  const double inv_speed = 1.0 / uav_speed_;
+  ws.dp.assign(total_points + 1, std::numeric_limits<double>::infinity());
+  ws.dp[0] = 0.0;
+  ws.prev_waypoint.assign(total_points + 1, -1);
+
+  if (manhattan) {
+    CdqManhattan(cols, inv_speed, wait_time_, ws, stats.candidates_evaluated).run();
+  }
+  else {
+    const std::vector<double>& position = ws.keys;
+    const int distinct = denseRanks(position.data(), cols.count, ws.order, ws.ranks);
+    ws.tree.resize(2 * (std::size_t)(distinct + 1));
+    MinFenwick below(ws.tree.data(), distinct);               // p_j <= p_i, by rank
+    MinFenwick above(ws.tree.data() + distinct + 1, distinct); // p_j > p_i, by mirrored rank
+    below.clear();
+    above.clear();
+
+    auto add = [&](int j) {
+      const double key = ws.dp[j] - cols.prefix[j];
+      below.insert(ws.ranks[j], RelaxResult{ key - position[j] * inv_speed, j });
+      above.insert(distinct - 1 - ws.ranks[j], RelaxResult{ key + position[j] * inv_speed, j });
+    };
+    add(0);
+    for (int i = 1; i <= total_points; ++i) {
+      RelaxResult best = below.query(ws.ranks[i], stats.candidates_evaluated);
+      best.min_time += position[i] * inv_speed;
+      if (ws.ranks[i] + 1 < distinct) {
+        RelaxResult farther = above.query(distinct - 2 - ws.ranks[i], stats.candidates_evaluated);
+        farther.min_time -= position[i] * inv_speed;
+        if (isBetterRelax(farther, best)) best = farther;
+      }
+      ws.dp[i] = best.min_time + cols.prefix[i - 1] + wait_time_;
+      ws.prev_waypoint[i] = best.best_prev;
+      if (i < total_points) add(i);
+    }
+  }
+
+  {
+    PhaseTimer timer(phaseSink(stats, SolvePhase::Reconstruct, profiling_));
+    reconstructPath(ws.prev_waypoint, total_points, path);
+  }
+  result = ws.dp[total_points];
+  return true;
+}
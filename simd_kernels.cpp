@@ -0,0 +1,311 @@
+#include "simd_kernels.h"
+#include "precision_policy.h"
+#include <cmath>
+#include <limits>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+#define DUAV_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC/Clang compile each vector kernel for its own instruction set so the
+// translation unit itself only assumes the baseline ISA. MSVC does not need
+// (or accept) per-function targets for intrinsics.
+#if defined(__GNUC__) || defined(__clang__)
+#define DUAV_TARGET(isa) __attribute__((target(isa)))
+#else
+#define DUAV_TARGET(isa)
+#endif
+
+namespace {
+
+/**
+ * @brief Reduces per-lane minima and indices to a single result following the
+ *        smallest-index tie-break of the scalar loop.
+ */
+template <int Lanes>
+RelaxResult reduceLanes(const double* lane_min, const double* lane_idx)
+{
+  RelaxResult best{ std::numeric_limits<double>::max(), -1 };
+  for (int l = 0; l < Lanes; ++l) {
+    const RelaxResult lane{ lane_min[l], (int)lane_idx[l] };
+    if (lane_idx[l] >= 0.0 && isBetterRelax(lane, best)) best = lane;
+  }
+  return best;
+}
+
+} // namespace
+
+
+/**
+ * @brief Portable scalar relaxation kernel
+ *
+ * Evaluates predecessors j in [j_begin, j_end) of waypoint i in ascending
+ * order and keeps the first (smallest j) candidate with the minimal time.
+ * Serves as fallback on CPUs without AVX2 and as the reference the vector
+ * kernels are checked against: the operations and their order are identical,
+ * so every kernel returns bit-identical results.
+ *
+ * @param cols    Waypoint columns (x, y, prefix)
+ * @param dp      Final DP values for all j < i
+ * @param i       Waypoint being relaxed (i >= 1)
+ * @param j_begin First predecessor to evaluate
+ * @param j_end   One past the last predecessor to evaluate (j_end <= i)
+ * @param speed   UAV cruising speed
+ * @return RelaxResult Minimal candidate time (without wait time) and its predecessor
+ */
+RelaxResult relaxScalar(const WaypointColumns& cols, const double* dp,
+  int i, int j_begin, int j_end, double speed)
+{
+  const double xi = cols.x[i];
+  const double yi = cols.y[i];
+  const double penalties_before_i = cols.prefix[i - 1];
+
+  RelaxResult best{ std::numeric_limits<double>::max(), -1 };
+  for (int j = j_begin; j < j_end; ++j) {
+    const double dx = xi - cols.x[j];
+    const double dy = yi - cols.y[j];
+    const double distance = std::sqrt(dx * dx + dy * dy);
+    const double time_candidate = dp[j] + distance / speed + (penalties_before_i - cols.prefix[j]);
+    if (time_candidate < best.min_time) {
+      best.min_time = time_candidate;
+      best.best_prev = j;
+    }
+  }
+  return best;
+}
+
+#if defined(DUAV_SIMD_X86)
+
+namespace {
+
+/**
+ * @brief AVX2 relaxation kernel: 4 predecessors per iteration
+ *
+ * Lane indices are tracked as doubles so that the compare mask can blend
+ * both the running minimum and its index. The remainder is handled by
+ * relaxScalar, which is compiled for the baseline ISA.
+ */
+DUAV_TARGET("avx2")
+RelaxResult relaxAvx2(const WaypointColumns& cols, const double* dp,
+  int i, int j_begin, int j_end, double speed)
+{
+  const __m256d xi = _mm256_set1_pd(cols.x[i]);
+  const __m256d yi = _mm256_set1_pd(cols.y[i]);
+  const __m256d penalties_before_i = _mm256_set1_pd(cols.prefix[i - 1]);
+  const __m256d speed_v = _mm256_set1_pd(speed);
+  const __m256d step = _mm256_set1_pd(4.0);
+
+  __m256d best_time = _mm256_set1_pd(std::numeric_limits<double>::max());
+  __m256d best_idx = _mm256_set1_pd(-1.0);
+  __m256d idx = _mm256_setr_pd(j_begin, j_begin + 1.0, j_begin + 2.0, j_begin + 3.0);
+
+  int j = j_begin;
+  for (; j + 4 <= j_end; j += 4) {
+    const __m256d dx = _mm256_sub_pd(xi, _mm256_loadu_pd(cols.x + j));
+    const __m256d dy = _mm256_sub_pd(yi, _mm256_loadu_pd(cols.y + j));
+    const __m256d dist = _mm256_sqrt_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)));
+    const __m256d sum_pen = _mm256_sub_pd(penalties_before_i, _mm256_loadu_pd(cols.prefix + j));
+    const __m256d candidate = _mm256_add_pd(
+      _mm256_add_pd(_mm256_loadu_pd(dp + j), _mm256_div_pd(dist, speed_v)), sum_pen);
+
+    const __m256d better = _mm256_cmp_pd(candidate, best_time, _CMP_LT_OQ);
+    best_time = _mm256_blendv_pd(best_time, candidate, better);
+    best_idx = _mm256_blendv_pd(best_idx, idx, better);
+    idx = _mm256_add_pd(idx, step);
+  }
+
+  alignas(32) double lane_min[4];
+  alignas(32) double lane_idx[4];
+  _mm256_store_pd(lane_min, best_time);
+  _mm256_store_pd(lane_idx, best_idx);
+  RelaxResult best = reduceLanes<4>(lane_min, lane_idx);
+
+  const RelaxResult tail = relaxScalar(cols, dp, i, j, j_end, speed);
+  return isBetterRelax(tail, best) ? tail : best;
+}
+
+/**
+ * @brief AVX-512 relaxation kernel: 8 predecessors per iteration
+ */
+DUAV_TARGET("avx512f")
+RelaxResult relaxAvx512(const WaypointColumns& cols, const double* dp,
+  int i, int j_begin, int j_end, double speed)
+{
+  const __m512d xi = _mm512_set1_pd(cols.x[i]);
+  const __m512d yi = _mm512_set1_pd(cols.y[i]);
+  const __m512d penalties_before_i = _mm512_set1_pd(cols.prefix[i - 1]);
+  const __m512d speed_v = _mm512_set1_pd(speed);
+  const __m512d step = _mm512_set1_pd(8.0);
+
+  __m512d best_time = _mm512_set1_pd(std::numeric_limits<double>::max());
+  __m512d best_idx = _mm512_set1_pd(-1.0);
+  __m512d idx = _mm512_setr_pd(j_begin, j_begin + 1.0, j_begin + 2.0, j_begin + 3.0,
+    j_begin + 4.0, j_begin + 5.0, j_begin + 6.0, j_begin + 7.0);
+
+  int j = j_begin;
+  for (; j + 8 <= j_end; j += 8) {
+    const __m512d dx = _mm512_sub_pd(xi, _mm512_loadu_pd(cols.x + j));
+    const __m512d dy = _mm512_sub_pd(yi, _mm512_loadu_pd(cols.y + j));
+    const __m512d dist = _mm512_sqrt_pd(_mm512_add_pd(_mm512_mul_pd(dx, dx), _mm512_mul_pd(dy, dy)));
+    const __m512d sum_pen = _mm512_sub_pd(penalties_before_i, _mm512_loadu_pd(cols.prefix + j));
+    const __m512d candidate = _mm512_add_pd(
+      _mm512_add_pd(_mm512_loadu_pd(dp + j), _mm512_div_pd(dist, speed_v)), sum_pen);
+
+    const __mmask8 better = _mm512_cmp_pd_mask(candidate, best_time, _CMP_LT_OQ);
+    best_time = _mm512_mask_blend_pd(better, best_time, candidate);
+    best_idx = _mm512_mask_blend_pd(better, best_idx, idx);
+    idx = _mm512_add_pd(idx, step);
+  }
+
+  alignas(64) double lane_min[8];
+  alignas(64) double lane_idx[8];
+  _mm512_store_pd(lane_min, best_time);
+  _mm512_store_pd(lane_idx, best_idx);
+  RelaxResult best = reduceLanes<8>(lane_min, lane_idx);
+
+  const RelaxResult tail = relaxScalar(cols, dp, i, j, j_end, speed);
+  return isBetterRelax(tail, best) ? tail : best;
+}
+
+/**
+ * @brief AVX2 kernel of FloatPolicy: 8 float distances per iteration
+ *
+ * The squared distances and square roots are computed on 8 float lanes and
+ * widened to two 4-lane double halves for the DP candidate, in the same
+ * order of operations as relaxScaled<FloatPolicy>. Lane l of the two halves
+ * tracks predecessors j = l (mod 8), so the lane reduction keeps the
+ * smallest-j tie-break.
+ */
+DUAV_TARGET("avx2")
+RelaxResult relaxFloatAvx2(const ScaledColumns<float>& cols, const double* prefix,
+  const double* dp, int i, int j_begin, int j_end, double speed)
+{
+  const __m256 xi = _mm256_set1_ps(cols.x[i]);
+  const __m256 yi = _mm256_set1_ps(cols.y[i]);
+  const __m256d penalties_before_i = _mm256_set1_pd(prefix[i - 1]);
+  const __m256d inv_scale = _mm256_set1_pd(cols.inv_scale);
+  const __m256d speed_v = _mm256_set1_pd(speed);
+  const __m256d step = _mm256_set1_pd(8.0);
+
+  __m256d best_lo = _mm256_set1_pd(std::numeric_limits<double>::max());
+  __m256d best_hi = best_lo;
+  __m256d best_idx_lo = _mm256_set1_pd(-1.0);
+  __m256d best_idx_hi = best_idx_lo;
+  __m256d idx_lo = _mm256_setr_pd(j_begin, j_begin + 1.0, j_begin + 2.0, j_begin + 3.0);
+  __m256d idx_hi = _mm256_add_pd(idx_lo, _mm256_set1_pd(4.0));
+
+  int j = j_begin;
+  for (; j + 8 <= j_end; j += 8) {
+    const __m256 dx = _mm256_sub_ps(xi, _mm256_loadu_ps(cols.x.data() + j));
+    const __m256 dy = _mm256_sub_ps(yi, _mm256_loadu_ps(cols.y.data() + j));
+    const __m256 dist = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)));
+    const __m256d dist_lo = _mm256_mul_pd(_mm256_cvtps_pd(_mm256_castps256_ps128(dist)), inv_scale);
+    const __m256d dist_hi = _mm256_mul_pd(_mm256_cvtps_pd(_mm256_extractf128_ps(dist, 1)), inv_scale);
+
+    const __m256d candidate_lo = _mm256_add_pd(
+      _mm256_add_pd(_mm256_loadu_pd(dp + j), _mm256_div_pd(dist_lo, speed_v)),
+      _mm256_sub_pd(penalties_before_i, _mm256_loadu_pd(prefix + j)));
+    const __m256d candidate_hi = _mm256_add_pd(
+      _mm256_add_pd(_mm256_loadu_pd(dp + j + 4), _mm256_div_pd(dist_hi, speed_v)),
+      _mm256_sub_pd(penalties_before_i, _mm256_loadu_pd(prefix + j + 4)));
+
+    const __m256d better_lo = _mm256_cmp_pd(candidate_lo, best_lo, _CMP_LT_OQ);
+    const __m256d better_hi = _mm256_cmp_pd(candidate_hi, best_hi, _CMP_LT_OQ);
+    best_lo = _mm256_blendv_pd(best_lo, candidate_lo, better_lo);
+    best_hi = _mm256_blendv_pd(best_hi, candidate_hi, better_hi);
+    best_idx_lo = _mm256_blendv_pd(best_idx_lo, idx_lo, better_lo);
+    best_idx_hi = _mm256_blendv_pd(best_idx_hi, idx_hi, better_hi);
+    idx_lo = _mm256_add_pd(idx_lo, step);
+    idx_hi = _mm256_add_pd(idx_hi, step);
+  }
+
+  alignas(32) double lane_min[8];
+  alignas(32) double lane_idx[8];
+  _mm256_store_pd(lane_min, best_lo);
+  _mm256_store_pd(lane_min + 4, best_hi);
+  _mm256_store_pd(lane_idx, best_idx_lo);
+  _mm256_store_pd(lane_idx + 4, best_idx_hi);
+  RelaxResult best = reduceLanes<8>(lane_min, lane_idx);
+
+  const RelaxResult tail = relaxScaled<FloatPolicy>(cols, prefix, dp, i, j, j_end, speed);
+  return isBetterRelax(tail, best) ? tail : best;
+}
+
+} // namespace
+
+#endif // DUAV_SIMD_X86
+
+
+/**
+ * @brief Detects the widest relaxation kernel supported by the running CPU
+ *        (and enabled by the operating system)
+ */
+SimdLevel detectSimdLevel()
+{
+#if defined(DUAV_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) return SimdLevel::Avx512;
+  if (__builtin_cpu_supports("avx2")) return SimdLevel::Avx2;
+#elif defined(DUAV_SIMD_X86) && defined(_MSC_VER)
+  int regs[4];
+  __cpuid(regs, 1);
+  const bool os_avx = (regs[2] & (1 << 27)) && (regs[2] & (1 << 28));  // OSXSAVE + AVX
+  if (os_avx) {
+    const unsigned long long xcr0 = _xgetbv(0);
+    __cpuidex(regs, 7, 0);
+    const bool avx2 = (regs[1] & (1 << 5)) && (xcr0 & 0x6) == 0x6;
+    const bool avx512f = (regs[1] & (1 << 16)) && (xcr0 & 0xe6) == 0xe6;
+    if (avx512f) return SimdLevel::Avx512;
+    if (avx2) return SimdLevel::Avx2;
+  }
+#endif
+  return SimdLevel::Scalar;
+}
+
+/**
+ * @brief Returns the kernel for the requested instruction set
+ *
+ * Levels the binary was not built with fall back to the scalar kernel. The
+ * caller is responsible for not requesting a level above detectSimdLevel().
+ */
+RelaxKernel relaxKernelFor(SimdLevel level)
+{
+#if defined(DUAV_SIMD_X86)
+  switch (level) {
+  case SimdLevel::Avx512: return relaxAvx512;
+  case SimdLevel::Avx2:   return relaxAvx2;
+  case SimdLevel::Scalar: break;
+  }
+#else
+  (void)level;
+#endif
+  return relaxScalar;
+}
+
+/**
+ * @brief Returns the FloatPolicy relaxation kernel for a SIMD level (the
+ *        AVX2 kernel also serves AVX-512 CPUs)
+ */
+ScaledRelaxKernel<float> floatRelaxKernelFor(SimdLevel level)
+{
+#if defined(DUAV_SIMD_X86)
+  if (level != SimdLevel::Scalar) return relaxFloatAvx2;
+#else
+  (void)level;
+#endif
+  return relaxScaled<FloatPolicy>;
+}
+
+const char* simdLevelName(SimdLevel level)
+{
+  switch (level) {
+  case SimdLevel::Avx512: return "avx512";
+  case SimdLevel::Avx2:   return "avx2";
+  case SimdLevel::Scalar: break;
+  }
+  return "scalar";
+}
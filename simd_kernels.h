@@ -0,0 +1,52 @@
+#pragma once
+
+#include "waypoint_soa.h"
+
+/**
+ * SimdLevel: instruction set used by the DP relaxation kernel.
+ * - Scalar: portable C++ loop, also the reference for the vector kernels.
+ * - Avx2:   4 candidates per iteration.
+ * - Avx512: 8 candidates per iteration.
+ */
+enum class SimdLevel {
+  Scalar,
+  Avx2,
+  Avx512
+};
+
+/**
+ * RelaxResult: minimum candidate time over a range of predecessors and the
+ * predecessor achieving it (smallest index among equal times, -1 if empty).
+ */
+struct RelaxResult {
+  double min_time;
+  int best_prev;
+};
+
+/**
+ * @brief Returns true if `b` is a better relaxation result than `a`: a lower
+ *        time, or the same time reached from a smaller predecessor index.
+ *        Every split or vectorized reduction combines partial results with
+ *        this rule so that it selects the same predecessor as a serial scan.
+ */
+inline bool isBetterRelax(const RelaxResult& b, const RelaxResult& a)
+{
+  if (b.best_prev < 0) return false;
+  if (a.best_prev < 0) return true;
+  return b.min_time < a.min_time || (b.min_time == a.min_time && b.best_prev < a.best_prev);
+}
+
+/**
+ * RelaxKernel: evaluates predecessors j in [j_begin, j_end) of waypoint i,
+ *   time(j) = dp[j] + sqrt(dx^2 + dy^2) / speed + (prefix[i-1] - prefix[j])
+ * and returns their min/argmin. All kernels produce bit-identical results.
+ */
+using RelaxKernel = RelaxResult (*)(const WaypointColumns& cols, const double* dp,
+  int i, int j_begin, int j_end, double speed);
+
+SimdLevel detectSimdLevel();
+RelaxKernel relaxKernelFor(SimdLevel level);
+const char* simdLevelName(SimdLevel level);
+
+RelaxResult relaxScalar(const WaypointColumns& cols, const double* dp,
+  int i, int j_begin, int j_end, double speed);
@@ -0,0 +1,76 @@
+#include "solve_profile.h"
+#include <fstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+const char* solvePhaseName(SolvePhase phase)
+{
+  switch (phase) {
+  case SolvePhase::Load:        return "load";
+  case SolvePhase::OpenOutput:  return "open_output";
+  case SolvePhase::Dp:          return "dp";
+  case SolvePhase::Reconstruct: return "reconstruct";
+  case SolvePhase::Output:      return "output";
+  case SolvePhase::Count:       break;
+  }
+  return "unknown";
+}
+
+/**
+ * @brief High-water mark of the process's resident memory in KiB
+ *
+ * Process-wide and never decreasing, so concurrent cases (batch mode) report
+ * the peak reached by the whole process so far. 0 where getrusage is missing.
+ */
+long peakResidentKiB()
+{
+#if defined(__unix__) || defined(__APPLE__)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#if defined(__APPLE__)
+    return (long)(usage.ru_maxrss / 1024);  // bytes on macOS
+#else
+    return (long)usage.ru_maxrss;
+#endif
+  }
+#endif
+  return 0;
+}
+
+/**
+ * @brief Writes the counters and phase timings of one solved case as a JSON
+ *        object, e.g. the sidecar `<output>.stats.json` of solveCase
+ *
+ * @param path       File to write
+ * @param input_path Input the statistics belong to (stored as "input")
+ * @param stats      Counters and phase timings of the case
+ * @return bool      False if the file cannot be written
+ */
+bool writeStatsJson(const std::string& path, const std::string& input_path, const SolveStats& stats)
+{
+  std::ofstream out(path);
+  if (!out.is_open()) return false;
+
+  std::string escaped;
+  for (const char c : input_path) {
+    if (c == '"' || c == '\\') escaped += '\\';
+    escaped += c;
+  }
+
+  out << "{\n  \"input\": \"" << escaped << "\",\n"
+    << "  \"cases\": " << stats.cases << ",\n"
+    << "  \"candidates_evaluated\": " << stats.candidates_evaluated << ",\n"
+    << "  \"blocks_skipped\": " << stats.blocks_skipped << ",\n"
+    << "  \"proven_optimal\": " << (stats.proven_optimal ? "true" : "false") << ",\n"
+    << "  \"optimality_gap\": " << stats.optimality_gap << ",\n"
+    << "  \"bytes_read\": " << stats.bytes_read << ",\n"
+    << "  \"peak_rss_kb\": " << stats.peak_rss_kb << ",\n"
+    << "  \"phases_us\": {";
+  for (int p = 0; p < static_cast<int>(SolvePhase::Count); ++p) {
+    out << (p ? ", " : "") << '"' << solvePhaseName(static_cast<SolvePhase>(p)) << "\": " << stats.phase_us[p];
+  }
+  out << "},\n  \"total_us\": " << stats.total_us << "\n}\n";
+  return static_cast<bool>(out);
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+
+#include "delivery_uav.h"
+
+/**
+ * PhaseTimer: adds the microseconds between construction and stop() (or
+ * destruction) to a SolveStats phase slot. A null sink disables the timer:
+ * no clock is read, so a disabled profile costs one branch per phase and
+ * nothing inside the DP loops.
+ */
+class PhaseTimer {
+public:
+  explicit PhaseTimer(long long* sink) : sink_(sink)
+  {
+    if (sink_) start_ = std::chrono::steady_clock::now();
+  }
+  ~PhaseTimer() { stop(); }
+
+  PhaseTimer(const PhaseTimer&) = delete;
+  PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+  void stop()
+  {
+    if (!sink_) return;
+    *sink_ += std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start_).count();
+    sink_ = nullptr;
+  }
+
+private:
+  long long* sink_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+/**
+ * @brief Returns the phase slot of `stats` when profiling is enabled, else nullptr
+ */
+inline long long* phaseSink(SolveStats& stats, SolvePhase phase, bool enabled)
+{
+  return enabled ? &stats.phase_us[static_cast<int>(phase)] : nullptr;
+}
+
+const char* solvePhaseName(SolvePhase phase);
+long peakResidentKiB();
+bool writeStatsJson(const std::string& path, const std::string& input_path, const SolveStats& stats);
@@ -0,0 +1,174 @@
+#include "solve_verify.h"
+#include "cost_model.h"
+#include "precision_policy.h"
+#include "simd_kernels.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <vector>
+
+namespace {
+
+const char* solverName(SolverMode mode)
+{
+  switch (mode) {
+  case SolverMode::Pruned:    return "pruned";
+  case SolverMode::Simd:      return "simd";
+  case SolverMode::Parallel:  return "parallel";
+  case SolverMode::Window:    return "window";
+  case SolverMode::Separable: return "separable";
+  case SolverMode::Spatial:   return "spatial";
+  case SolverMode::Gpu:       return "gpu";
+  case SolverMode::Baseline:  break;
+  }
+  return "baseline";
+}
+
+/**
+ * @brief Time of a path evaluated leg by leg like DeliveryUAV::solve:
+ *        t = (t + travel + skipped penalties) + wait, departing at t
+ *        (infinity for a path that is not a valid course)
+ */
+double pathTime(const DeliveryUAV& uav, const WaypointColumns& cols, const std::vector<int>& path)
+{
+  if (path.size() < 2 || path.front() != 0 || path.back() != cols.count - 1) {
+    return std::numeric_limits<double>::infinity();
+  }
+  return dispatchCostModel(uav.costModel(), uav.speed(), [&](const auto& cost) {
+    double time = 0.0;
+    for (std::size_t k = 1; k < path.size(); ++k) {
+      const int j = path[k - 1], i = path[k];
+      if (i <= j || i >= cols.count) return std::numeric_limits<double>::infinity();
+      const double travel = cost.travelTime(cols.x[j], cols.y[j], cols.x[i], cols.y[i], j, i, time);
+      time = time + travel + (cols.prefix[i - 1] - cols.prefix[j]) + uav.waitTime();
+    }
+    return time;
+  });
+}
+
+/**
+ * @brief Solver mode solveRoute() actually runs: only the scalar solvers
+ *        are specialized on a non-Euclidean cost model
+ */
+SolverMode effectiveMode(const DeliveryUAV& uav)
+{
+  const CostModel* model = uav.costModel();
+  const SolverMode mode = uav.solverMode();
+  if (model && model->kind != CostModelKind::Euclidean && mode != SolverMode::Pruned &&
+    mode != SolverMode::Separable && mode != SolverMode::Spatial) {
+    return SolverMode::Baseline;
+  }
+  return mode;
+}
+
+template <typename Fn>
+long long timeUs(Fn&& fn)
+{
+  const auto start = std::chrono::steady_clock::now();
+  fn();
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+
+/**
+ * @brief Solves a route with the UAV's solver and with the reference DP
+ *        (SolverMode::Baseline) and checks the result
+ *
+ * The time must match the reference within `tolerance` (relative, at least
+ * absolute for times below 1). The path passes if it is identical, or if
+ * the optimized path re-evaluated with the reference arithmetic costs the
+ * reference time within the same tolerance (a tie resolved under other
+ * rounding). Solvers that share the candidate arithmetic of a reference
+ * must also match it bit for bit, which checks the tie-break rule (see
+ * solve_verify.h) of the fast path:
+ * - Baseline, Pruned, Spatial: against Baseline;
+ * - Simd, Parallel, Gpu in double precision: against the scalar simd kernel
+ *   on one thread, untiled.
+ *
+ * @param uav       Configured UAV; its speed, wait time and cost model are used
+ * @param cols      Columns of [start, wp1, wp2..., terminal] with penalty prefix sums
+ * @param tolerance Relative tolerance of the time check, e.g. 1e-9
+ * @return VerifyReport Times, path comparison, exact check and wall times
+ */
+VerifyReport verifySolve(const DeliveryUAV& uav, const WaypointColumns& cols, double tolerance)
+{
+  DeliveryUAV reference(uav.speed(), uav.waitTime());
+  reference.setSolverMode(SolverMode::Baseline);
+  reference.setCostModel(uav.costModel() ? std::make_shared<CostModel>(*uav.costModel()) : nullptr);
+
+  VerifyReport report;
+  report.mode = effectiveMode(uav);
+  std::vector<int> path, reference_path;
+  report.solve_us = timeUs([&] { report.time = uav.solveRoute(cols, path); });
+  report.reference_us = timeUs([&] { report.reference_time = reference.solveRoute(cols, reference_path); });
+
+  const double allowed = tolerance * std::max(1.0, std::fabs(report.reference_time));
+  report.time_ok = std::fabs(report.time - report.reference_time) <= allowed;
+
+  const std::size_t common = std::min(path.size(), reference_path.size());
+  for (std::size_t k = 0; k < common && report.first_divergence < 0; ++k) {
+    if (path[k] != reference_path[k]) report.first_divergence = (long long)k;
+  }
+  if (report.first_divergence < 0 && path.size() != reference_path.size()) report.first_divergence = (long long)common;
+  report.path_time = pathTime(uav, cols, path);
+  if (report.first_divergence < 0) report.path_match = PathMatch::Identical;
+  else if (report.path_time - report.reference_time <= allowed) report.path_match = PathMatch::Tie;
+  else report.path_match = PathMatch::Mismatch;
+
+  const bool double_precision = uav.precision() == Precision::Double;
+  switch (report.mode) {
+  case SolverMode::Baseline:
+  case SolverMode::Pruned:
+  case SolverMode::Spatial:
+    report.exact_reference = "baseline";
+    report.exact_ok = report.time == report.reference_time && report.first_divergence < 0;
+    break;
+  case SolverMode::Simd:
+  case SolverMode::Parallel:
+  case SolverMode::Gpu:
+    if (double_precision) {
+      DeliveryUAV scalar(uav.speed(), uav.waitTime());
+      scalar.setSolverMode(SolverMode::Simd);
+      scalar.setSimdLevel(SimdLevel::Scalar);
+      std::vector<int> scalar_path;
+      const double scalar_time = scalar.solveRoute(cols, scalar_path);
+      report.exact_reference = "simd scalar";
+      report.exact_ok = report.time == scalar_time && path == scalar_path;
+    }
+    break;
+  case SolverMode::Window:
+  case SolverMode::Separable:
+    break;
+  }
+  return report;
+}
+
+/**
+ * @brief Prints a VerifyReport as one line, e.g.
+ *   Verify (pruned vs baseline): PASS, time 2977.083000 vs 2977.083000 (abs diff 0.000e+00),
+ *   path identical, tie-break exact vs baseline, speedup 12.40x (52 us vs 645 us)
+ */
+void printVerifyReport(std::ostream& out, const VerifyReport& report)
+{
+  const std::ios_base::fmtflags flags = out.flags();
+  const std::streamsize precision = out.precision();
+  out << "Verify (" << solverName(report.mode) << " vs baseline): " << (report.passed() ? "PASS" : "FAIL")
+    << ", time " << std::fixed << std::setprecision(6) << report.time << " vs " << report.reference_time
+    << std::scientific << std::setprecision(3) << " (abs diff " << std::fabs(report.time - report.reference_time)
+    << (report.time_ok ? ")" : ", out of tolerance)") << ", path ";
+  switch (report.path_match) {
+  case PathMatch::Identical: out << "identical"; break;
+  case PathMatch::Tie:       out << "tie at position " << report.first_divergence; break;
+  case PathMatch::Mismatch:  out << "MISMATCH at position " << report.first_divergence; break;
+  }
+  if (report.exact_reference) {
+    out << ", tie-break " << (report.exact_ok ? "exact" : "VIOLATED") << " vs " << report.exact_reference;
+  }
+  out << std::fixed << std::setprecision(2) << ", speedup " << report.speedup() << "x ("
+    << report.solve_us << " us vs " << report.reference_us << " us)\n";
+  out.flags(flags);
+  out.precision(precision);
+}
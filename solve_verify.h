@@ -0,0 +1,64 @@
+#pragma once
+
+#include <ostream>
+
+#include "delivery_uav.h"
+#include "waypoint_soa.h"
+
+/**
+ * Verification of an optimized solver against the reference DP.
+ *
+ * Tie-break rule: among predecessors whose candidate times compare equal,
+ * every solver picks the smallest index j, i.e. the predecessor the serial
+ * ascending scan of DeliveryUAV::solve keeps with `time_candidate < min_time`.
+ * Backward scans use `<=`, and split or vectorized scans merge their partial
+ * minima with isBetterRelax (simd_kernels.h). A solver that evaluates the
+ * candidates with the same arithmetic as a reference therefore returns the
+ * same time and path bit for bit; one with other rounding may pick another
+ * path of equal cost within rounding.
+ */
+
+/**
+ * PathMatch: how the path of the optimized solve relates to the reference.
+ * - Identical: same visited points.
+ * - Tie:       other points, but re-evaluated with the reference arithmetic
+ *              the path costs the reference time within tolerance.
+ * - Mismatch:  the path is slower than the reference (or invalid).
+ */
+enum class PathMatch {
+  Identical,
+  Tie,
+  Mismatch
+};
+
+/**
+ * VerifyReport: optimized solve of a route next to the reference solve.
+ * - time / reference_time: minimum times of the optimized solver and of
+ *   SolverMode::Baseline with the same parameters and cost model.
+ * - path_time: the optimized path re-evaluated with the reference arithmetic.
+ * - first_divergence: first path position that differs (-1 if identical).
+ * - exact_reference: reference with the same candidate arithmetic as the
+ *   optimized solver ("baseline" or "simd scalar"), nullptr if there is none
+ *   (other coordinate precision, separable keys); exact_ok: time and path
+ *   are bit-identical to it, i.e. the tie-break rule holds.
+ * - solve_us / reference_us: wall time of both solves.
+ */
+struct VerifyReport {
+  SolverMode mode = SolverMode::Baseline;
+  double time = 0.0;
+  double reference_time = 0.0;
+  double path_time = 0.0;
+  bool time_ok = false;
+  PathMatch path_match = PathMatch::Mismatch;
+  long long first_divergence = -1;
+  const char* exact_reference = nullptr;
+  bool exact_ok = true;
+  long long solve_us = 0;
+  long long reference_us = 0;
+
+  double speedup() const { return solve_us > 0 ? (double)reference_us / solve_us : 0.0; }
+  bool passed() const { return time_ok && path_match != PathMatch::Mismatch && exact_ok; }
+};
+
+VerifyReport verifySolve(const DeliveryUAV& uav, const WaypointColumns& cols, double tolerance);
+void printVerifyReport(std::ostream& out, const VerifyReport& report);
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "delivery_uav.h"
+#include "precision_policy.h"
+#include "route_file.h"
+#include "simd_kernels.h"
+#include "waypoint_soa.h"
+
+/**
+ * PaddedRelaxResult: per-task partial result of a parallel row relaxation,
+ * padded to a cache line so that threads never write to a shared line.
+ */
+struct alignas(64) PaddedRelaxResult {
+  RelaxResult result;
+};
+
+/**
+ * RouteLabel: r-th best way to reach a point in the top-K solver: its time
+ * (including the wait) and the label (point, rank) it extends.
+ */
+struct RouteLabel {
+  double time;
+  int prev;
+  int prev_rank;
+};
+
+/**
+ * BlockBox: bounding box of a block (or group of blocks) of consecutive points
+ * in the spatial solver.
+ */
+struct BlockBox {
+  double min_x, max_x;
+  double min_y, max_y;
+};
+
+/**
+ * FleetScratch: DP state of one segment of the fleet solver (slot 0 = start).
+ */
+struct FleetScratch {
+  std::vector<double> dp;
+  std::vector<double> floor;
+  std::vector<int> prev;
+};
+
+/**
+ * SolveWorkspace: scratch buffers reused by consecutive solves.
+ *
+ * Every buffer is resized (never shrunk) to the case at hand, so after the
+ * largest case has been seen a solve performs no heap allocation for its DP
+ * state, input columns or path. DeliveryUAV uses one workspace per thread
+ * unless one is installed with DeliveryUAV::setWorkspace(). A workspace must
+ * only be used by one solve at a time.
+ */
+struct SolveWorkspace {
+  RouteFile input;                        // solveCase input and its SoA columns
+  std::vector<int> path;                  // solveCase optimal path
+  std::vector<char> cache_route;          // solveCase raw input kept for the result cache after parsing
+  WaypointSoA route;                      // solveRoute(RouteInput) staging columns
+  AlignedVector<double> dp;               // DP values (ring buffer for the window solver)
+  std::vector<double> floor;              // pruning bound
+  std::vector<int> prev_waypoint;         // predecessor links (segment links when checkpointing)
+  std::vector<double> checkpoints;        // window solver low-memory checkpoints
+  std::vector<int> hops;                  // window solver low-memory: path from the terminal backwards
+  AlignedVector<PaddedRelaxResult> partial;  // parallel row partials
+  ScaledColumns<float> float_coords;      // Precision::Float coordinates
+  ScaledColumns<std::int32_t> fixed_coords;  // Precision::Fixed coordinates
+  std::vector<double> keys;               // separable solver: dp[j] - prefix[j], corridor positions
+  std::vector<int> ranks;                 // separable solver: coordinate ranks
+  std::vector<int> order;                 // separable solver: sort orders
+  std::vector<RelaxResult> tree;          // separable solver: Fenwick min-trees
+  std::vector<RelaxResult> best;          // separable and tiled solvers: best predecessor so far
+  std::vector<BlockBox> block_box;        // spatial solver: bounding box per block
+  std::vector<double> block_key;          // spatial solver: min dp - prefix per block
+  std::vector<BlockBox> group_box;        // spatial solver: bounding box per group of blocks
+  std::vector<double> group_key;          // spatial solver: min dp - prefix per group
+  std::vector<double> upper;              // anytime solver: DP values of the heuristic route
+  std::vector<int> upper_prev;            // anytime solver: predecessor links of the heuristic
+  std::vector<RouteLabel> labels;         // top-K solver: K labels per point
+  std::vector<int> label_count;           // top-K solver: labels per point
+  std::vector<RouteAlternative> alternatives;  // solveCase top-K routes
+  AnytimeResult anytime;                  // solveCase deadline-bounded route
+  std::vector<FleetScratch> fleet_scratch;  // fleet solver: one segment DP per task
+  std::vector<double> fleet_value;        // fleet solver: best value per (drones, last waypoint)
+  std::vector<int> fleet_split;           // fleet solver: first waypoint of the last drone
+  std::vector<double> fleet_rows;         // fleet solver: segment costs of one block of starts
+  FleetResult fleet;                      // solveCase fleet result
+  std::vector<WayPoint> waypoints;        // reference solver copy of the columns
+  std::vector<double> prefix;             // reference solver copy of the prefix sums
+  std::vector<double> sweep_params;       // parameter sweep: 1 / speed and wait time per set
+  std::vector<double> sweep_min_time;     // parameter sweep: best time of the current row per set
+  std::vector<int> sweep_best_prev;       // parameter sweep: best predecessor of the current row per set
+
+  /**
+   * @brief Bytes reserved by the solver scratch buffers (DP state and
+   *        per-solver structures; the input columns and paths excluded)
+   */
+  std::size_t scratchBytes() const
+  {
+    std::size_t bytes = 0;
+    auto add = [&](const auto& buffer) { bytes += buffer.capacity() * sizeof(buffer[0]); };
+    add(dp); add(floor); add(prev_waypoint); add(checkpoints); add(hops); add(partial);
+    add(float_coords.x); add(float_coords.y); add(fixed_coords.x); add(fixed_coords.y);
+    add(keys); add(ranks); add(order); add(tree); add(best);
+    add(block_box); add(block_key); add(group_box); add(group_key);
+    add(upper); add(upper_prev); add(labels); add(label_count);
+    add(fleet_value); add(fleet_split); add(fleet_rows);
+    for (const FleetScratch& scratch : fleet_scratch) {
+      add(scratch.dp); add(scratch.floor); add(scratch.prev);
+    }
+    add(waypoints); add(prefix);
+    add(sweep_params); add(sweep_min_time); add(sweep_best_prev);
+    return bytes;
+  }
+};
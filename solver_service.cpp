@@ -0,0 +1,657 @@
+#include "solver_service.h"
+#include <algorithm>
+#include <iostream>
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include "binary_route.h"
+#include "result_cache.h"
+#include "waypoint_loader.h"
+#include "waypoint_soa.h"
+#include <arpa/inet.h>
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <netinet/in.h>
+#include <new>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Payload buffers grow by at least this much as the bytes arrive
+constexpr std::size_t kPayloadChunkBytes = 64 * 1024;
+// Completed requests kept for the latency percentiles
+constexpr std::size_t kLatencyWindow = 4096;
+
+/**
+ * Connection: one client socket. Workers answer requests of the same
+ * connection concurrently, so writes are serialized by a mutex. The socket
+ * is closed when the reader and every pending request are done with it.
+ */
+class Connection {
+public:
+  explicit Connection(int fd) : fd_(fd) {}
+  ~Connection() { ::close(fd_); }
+
+  Connection(const Connection&) = delete;
+  Connection& operator=(const Connection&) = delete;
+
+  int fd() const { return fd_; }
+
+  bool send(const std::string& text)
+  {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    const char* data = text.data();
+    std::size_t left = text.size();
+    while (left > 0) {
+      const ssize_t sent = ::send(fd_, data, left, MSG_NOSIGNAL);
+      if (sent < 0 && errno == EINTR) continue;
+      if (sent <= 0) return false;
+      data += sent;
+      left -= (std::size_t)sent;
+    }
+    return true;
+  }
+
+private:
+  int fd_;
+  std::mutex write_mutex_;
+};
+
+/**
+ * SocketReader: buffered reads of header lines and fixed-size payloads.
+ */
+class SocketReader {
+public:
+  explicit SocketReader(int fd) : fd_(fd), buffer_(64 * 1024) {}
+
+  bool readLine(std::string& line, std::size_t max_length)
+  {
+    line.clear();
+    for (;;) {
+      if (pos_ == end_ && !fill()) return false;
+      const char c = buffer_[pos_++];
+      if (c == '\n') return true;
+      if (c != '\r') line += c;
+      if (line.size() > max_length) return false;
+    }
+  }
+
+  bool readExact(char* out, std::size_t bytes)
+  {
+    while (bytes > 0) {
+      if (pos_ == end_ && !fill()) return false;
+      const std::size_t take = std::min(bytes, end_ - pos_);
+      std::memcpy(out, buffer_.data() + pos_, take);
+      pos_ += take;
+      out += take;
+      bytes -= take;
+    }
+    return true;
+  }
+
+  /**
+   * @brief Reads a payload of `bytes` bytes into `out`, growing it
+   *        geometrically as data arrives, so a declared size costs no
+   *        memory until the client actually sends the bytes
+   */
+  bool readPayload(AlignedVector<char>& out, std::size_t bytes)
+  {
+    out.clear();
+    while (out.size() < bytes) {
+      const std::size_t have = out.size();
+      const std::size_t grow = std::max(kPayloadChunkBytes, have);
+      out.resize(have + std::min(grow, bytes - have));
+      if (!readExact(out.data() + have, out.size() - have)) return false;
+    }
+    return true;
+  }
+
+private:
+  bool fill()
+  {
+    for (;;) {
+      const ssize_t got = ::recv(fd_, buffer_.data(), buffer_.size(), 0);
+      if (got < 0 && errno == EINTR) continue;
+      if (got <= 0) return false;
+      pos_ = 0;
+      end_ = (std::size_t)got;
+      return true;
+    }
+  }
+
+  int fd_;
+  std::vector<char> buffer_;
+  std::size_t pos_ = 0;
+  std::size_t end_ = 0;
+};
+
+/**
+ * Request: one queued SOLVE frame. The payload is 64-byte aligned so that
+ * float64 binary routes are solved in place.
+ */
+struct Request {
+  std::shared_ptr<Connection> connection;
+  std::string id;
+  bool binary = false;
+  AlignedVector<char> payload;
+  Clock::time_point received;
+  Clock::time_point deadline;  // time_point::max() = none
+};
+
+/**
+ * @brief Result cache part of the STATS answer (mean lookup time, hashing included)
+ */
+std::string cacheReport(const ResultCacheStats& stats)
+{
+  char text[256];
+  std::snprintf(text, sizeof(text), " cache_lookups=%lld cache_hits=%lld cache_hit_rate=%.4f cache_lookup_us=%.2f"
+    " cache_entries=%zu cache_bytes=%zu cache_evictions=%lld", stats.lookups, stats.hits, stats.hitRate(),
+    stats.meanLookupUs(), stats.entries, stats.bytes, stats.evictions);
+  return text;
+}
+
+/**
+ * ServiceMetrics: request counters, queue depth and a window of recent
+ * end-to-end latencies (receipt to response) for the percentiles.
+ */
+class ServiceMetrics {
+public:
+  void recordLatency(long long latency_us)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (latencies_.size() < kLatencyWindow) latencies_.push_back(latency_us);
+    else latencies_[next_++ % kLatencyWindow] = latency_us;
+  }
+
+  std::string report(std::size_t queue_depth, int workers, const ResultCache* cache)
+  {
+    std::vector<long long> sorted;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      sorted = latencies_;
+    }
+    std::sort(sorted.begin(), sorted.end());
+    // Nearest-rank percentiles over the latency window
+    auto percentile = [&](double p) -> long long {
+      if (sorted.empty()) return 0;
+      const std::size_t rank = (std::size_t)std::max(1.0, std::ceil(p * sorted.size()));
+      return sorted[std::min(rank, sorted.size()) - 1];
+    };
+    return "STATS received=" + std::to_string(received.load()) +
+      " completed=" + std::to_string(completed.load()) +
+      " failed=" + std::to_string(failed.load()) +
+      " expired=" + std::to_string(expired.load()) +
+      " queue_depth=" + std::to_string(queue_depth) +
+      " max_queue_depth=" + std::to_string(max_queue_depth.load()) +
+      " p50_us=" + std::to_string(percentile(0.50)) +
+      " p99_us=" + std::to_string(percentile(0.99)) +
+      " workers=" + std::to_string(workers) + (cache ? cacheReport(cache->stats()) : std::string()) + "\n";
+  }
+
+  std::atomic<long long> received{ 0 };
+  std::atomic<long long> completed{ 0 };
+  std::atomic<long long> failed{ 0 };
+  std::atomic<long long> expired{ 0 };
+  std::atomic<std::size_t> max_queue_depth{ 0 };
+
+private:
+  std::mutex mutex_;
+  std::vector<long long> latencies_;
+  std::size_t next_ = 0;
+};
+
+/**
+ * RequestQueue: FIFO shared by the connection readers and the workers.
+ * popBatch() hands a worker up to max_batch requests per wakeup.
+ */
+class RequestQueue {
+public:
+  explicit RequestQueue(ServiceMetrics& metrics) : metrics_(metrics) {}
+
+  void push(std::unique_ptr<Request> request)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    requests_.push_back(std::move(request));
+    std::size_t depth = requests_.size();
+    std::size_t seen = metrics_.max_queue_depth.load();
+    while (depth > seen && !metrics_.max_queue_depth.compare_exchange_weak(seen, depth)) {}
+    ready_.notify_one();
+  }
+
+  bool popBatch(std::vector<std::unique_ptr<Request>>& batch, int max_batch)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    ready_.wait(lock, [&] { return !requests_.empty() || stopped_; });
+    if (requests_.empty()) return false;
+    while (!requests_.empty() && (int)batch.size() < max_batch) {
+      batch.push_back(std::move(requests_.front()));
+      requests_.pop_front();
+    }
+    if (!requests_.empty()) ready_.notify_one();
+    return true;
+  }
+
+  std::size_t depth()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return requests_.size();
+  }
+
+  void stop()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopped_ = true;
+    ready_.notify_all();
+  }
+
+private:
+  ServiceMetrics& metrics_;
+  std::mutex mutex_;
+  std::condition_variable ready_;
+  std::deque<std::unique_ptr<Request>> requests_;
+  bool stopped_ = false;
+};
+
+/**
+ * @brief Formats the answer to a solved request:
+ *        OK <id> time=<s> solve_us=<us> latency_us=<us> path=<i1>,<i2>,...
+ *        (waypoint indices 1..N, start and terminal excluded), followed by
+ *        " optimal=<0|1> gap=<fraction>" for a deadline-bounded solve
+ */
+std::string formatAnswer(const std::string& id, double total_time, long long solve_us,
+  long long latency_us, const std::vector<int>& path, const AnytimeResult* bounded)
+{
+  char time_text[64];
+  std::snprintf(time_text, sizeof(time_text), "%.3f", total_time);
+  std::string answer = "OK " + id + " time=" + time_text + " solve_us=" + std::to_string(solve_us) +
+    " latency_us=" + std::to_string(latency_us) + " path=";
+  char index_text[16];
+  for (size_t k = 1; k + 1 < path.size(); ++k) {
+    if (k > 1) answer += ',';
+    const auto result = std::to_chars(index_text, index_text + sizeof(index_text), path[k]);
+    answer.append(index_text, result.ptr);
+  }
+  if (bounded) {
+    char gap_text[64];
+    std::snprintf(gap_text, sizeof(gap_text), "%.6f", bounded->gap);
+    answer += std::string(" optimal=") + (bounded->optimal ? "1" : "0") + " gap=" + gap_text;
+  }
+  answer += '\n';
+  return answer;
+}
+
+/**
+ * Service: listening socket, connection readers and solver workers.
+ */
+class Service {
+public:
+  Service(const ServiceConfig& config, const UavFactory& make_uav)
+    : config_(config), make_uav_(make_uav), queue_(metrics_) {}
+
+  int run();
+
+private:
+  /**
+   * ReaderThread: reader of one connection; `done` is set when it returns,
+   * so the accept loop can join it while the service keeps running.
+   */
+  struct ReaderThread {
+    std::thread thread;
+    std::weak_ptr<Connection> connection;
+    std::atomic<bool> done{ false };
+  };
+
+  int listen(std::string& error);
+  void reapReaders();
+  void readConnection(std::shared_ptr<Connection> connection);
+  void workerLoop(DeliveryUAV uav);
+  void answer(DeliveryUAV& uav, Request& request, WaypointSoA& soa, AnytimeResult& route);
+  void finish(Request& request, Clock::time_point start, const AnytimeResult& route, bool bounded);
+
+  const ServiceConfig& config_;
+  const UavFactory& make_uav_;
+  ServiceMetrics metrics_;
+  RequestQueue queue_;
+  std::atomic<bool> stop_{ false };
+  std::list<ReaderThread> readers_;  // accept loop only; nodes stay in place for `done`
+};
+
+/**
+ * @brief Binds and listens on the configured endpoint
+ * @return int Listening socket, or -1 with `error` set
+ */
+int Service::listen(std::string& error)
+{
+  const std::string& endpoint = config_.endpoint;
+  int fd = -1;
+  if (endpoint.compare(0, 5, "unix:") == 0) {
+    const std::string path = endpoint.substr(5);
+    sockaddr_un address{};
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+      error = "invalid unix socket path '" + path + "'";
+      return -1;
+    }
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    ::unlink(path.c_str());  // stale socket of a previous run
+    fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || ::bind(fd, (const sockaddr*)&address, sizeof(address)) != 0) {
+      error = "cannot bind " + endpoint + ": " + std::strerror(errno);
+      if (fd >= 0) ::close(fd);
+      return -1;
+    }
+  }
+  else if (endpoint.compare(0, 4, "tcp:") == 0) {
+    std::string host = "127.0.0.1";
+    std::string port = endpoint.substr(4);
+    const size_t colon = port.rfind(':');
+    if (colon != std::string::npos) {
+      host = port.substr(0, colon);
+      port = port.substr(colon + 1);
+    }
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    int port_number = 0;
+    const auto parsed = std::from_chars(port.data(), port.data() + port.size(), port_number);
+    if (parsed.ec != std::errc() || parsed.ptr != port.data() + port.size() || port_number <= 0 ||
+      port_number > 65535 || ::inet_pton(AF_INET, host.c_str(), &address.sin_addr) != 1) {
+      error = "invalid tcp endpoint '" + endpoint + "' (expected tcp:[host:]port)";
+      return -1;
+    }
+    address.sin_port = htons((uint16_t)port_number);
+    fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    const int reuse = 1;
+    if (fd >= 0) ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    if (fd < 0 || ::bind(fd, (const sockaddr*)&address, sizeof(address)) != 0) {
+      error = "cannot bind " + endpoint + ": " + std::strerror(errno);
+      if (fd >= 0) ::close(fd);
+      return -1;
+    }
+  }
+  else {
+    error = "unknown endpoint '" + endpoint + "' (expected unix:<path> or tcp:[host:]port)";
+    return -1;
+  }
+
+  if (::listen(fd, 64) != 0) {
+    error = "cannot listen on " + endpoint + ": " + std::strerror(errno);
+    ::close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+/**
+ * @brief Reads the frames of one connection until it closes
+ *
+ * Frames (one header line, then the payload for SOLVE):
+ *   SOLVE <id> <text|binary> <bytes> [deadline_ms]
+ *   STATS
+ *   SHUTDOWN
+ * SOLVE frames are queued and answered by the workers, possibly out of
+ * order; STATS is answered immediately.
+ */
+void Service::readConnection(std::shared_ptr<Connection> connection)
+{
+  SocketReader reader(connection->fd());
+  std::string line;
+  while (!stop_.load() && reader.readLine(line, 4096)) {
+    if (line.empty()) continue;
+    char command[16] = {};
+    char id[256] = {};
+    char format[16] = {};
+    unsigned long long bytes = 0;
+    double deadline_ms = config_.default_deadline_ms;
+    const int fields = std::sscanf(line.c_str(), "%15s %255s %15s %llu %lf", command, id, format, &bytes, &deadline_ms);
+
+    if (std::strcmp(command, "STATS") == 0) {
+      connection->send(metrics_.report(queue_.depth(), config_.workers, config_.cache.get()));
+      continue;
+    }
+    if (std::strcmp(command, "SHUTDOWN") == 0) {
+      stop_.store(true);
+      connection->send("BYE\n");
+      break;
+    }
+    const bool binary = std::strcmp(format, "binary") == 0;
+    if (std::strcmp(command, "SOLVE") != 0 || fields < 4 || (!binary && std::strcmp(format, "text") != 0)) {
+      connection->send("ERR - malformed request header\n");
+      break;  // the payload length is unknown, so the stream cannot be resynchronized
+    }
+    if (bytes > config_.max_payload_bytes) {
+      connection->send(std::string("ERR ") + id + " payload too large (limit " +
+        std::to_string(config_.max_payload_bytes) + " bytes)\n");
+      break;
+    }
+
+    auto request = std::make_unique<Request>();
+    request->connection = connection;
+    request->id = id;
+    request->binary = binary;
+    try {
+      if (!reader.readPayload(request->payload, (size_t)bytes)) break;
+    }
+    catch (const std::bad_alloc&) {
+      connection->send(std::string("ERR ") + id + " out of memory for the payload\n");
+      break;
+    }
+    request->received = Clock::now();
+    request->deadline = deadline_ms > 0.0
+      ? request->received + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(deadline_ms))
+      : Clock::time_point::max();
+    metrics_.received.fetch_add(1);
+    queue_.push(std::move(request));
+  }
+}
+
+/**
+ * @brief Solves one request with the worker's UAV and warm buffers and sends
+ *        the answer (OK, ERR or EXPIRED when the deadline passed in the queue)
+ *
+ * A request with a deadline is solved with DeliveryUAV::solveWithinDeadline
+ * in the time left, so a late request still gets the best route found.
+ */
+void Service::answer(DeliveryUAV& uav, Request& request, WaypointSoA& soa, AnytimeResult& route)
+{
+  const auto start = Clock::now();
+  if (start > request.deadline) {
+    metrics_.expired.fetch_add(1);
+    request.connection->send("EXPIRED " + request.id + "\n");
+    return;
+  }
+
+  const char* data = request.payload.data();
+  const std::size_t size = request.payload.size();
+  const bool bounded = request.deadline != Clock::time_point::max();
+  ResultCache* cache = uav.resultCache();
+  ResultCacheKey cache_key;
+  if (cache && cache->find(data, size, uav.cacheParams(), cache_key, route.total_time, route.path)) {
+    route.optimal = true;
+    route.gap = 0.0;
+    finish(request, start, route, bounded);
+    return;
+  }
+
+  // The declared waypoint count is bounded by the payload size in both
+  // formats; the try also covers an allocation failure while parsing
+  try {
+    std::string error;
+    WaypointColumns cols;
+    BinaryRouteView binary_view;
+    if (request.binary) {
+      if (!binary_view.open(data, size, error)) error = "invalid binary route: " + error;
+      cols = binary_view.columns();
+    }
+    else if (parseWaypointText(data, data + size, soa, error)) {
+      cols = soa.columns();
+    }
+    else {
+      error = "invalid input format, " + error;
+    }
+    if (!error.empty()) {
+      metrics_.failed.fetch_add(1);
+      request.connection->send("ERR " + request.id + " " + error + "\n");
+      return;
+    }
+
+    if (bounded) {
+      const double remaining_ms = std::chrono::duration<double, std::milli>(request.deadline - start).count();
+      uav.solveWithinDeadline(cols, remaining_ms, route);
+    }
+    else {
+      route.total_time = uav.solveRoute(cols, route.path);
+    }
+  }
+  catch (const std::exception& e) {  // e.g. a distance matrix of another size, or bad_alloc
+    metrics_.failed.fetch_add(1);
+    request.connection->send("ERR " + request.id + " " + e.what() + "\n");
+    return;
+  }
+  if (cache && (!bounded || route.optimal)) cache->store(cache_key, data, size, route.total_time, route.path);
+  finish(request, start, route, bounded);
+}
+
+/**
+ * @brief Sends the OK answer of a solved or cached request and records it
+ */
+void Service::finish(Request& request, Clock::time_point start, const AnytimeResult& route, bool bounded)
+{
+  const auto done = Clock::now();
+  const long long solve_us = std::chrono::duration_cast<std::chrono::microseconds>(done - start).count();
+  const long long latency_us = std::chrono::duration_cast<std::chrono::microseconds>(done - request.received).count();
+  request.connection->send(formatAnswer(request.id, route.total_time, solve_us, latency_us, route.path,
+    bounded ? &route : nullptr));
+  metrics_.completed.fetch_add(1);
+  metrics_.recordLatency(latency_us);
+}
+
+void Service::workerLoop(DeliveryUAV uav)
+{
+  WaypointSoA soa;        // parsed text payloads, reused across requests
+  AnytimeResult route;    // path reused across requests
+  std::vector<std::unique_ptr<Request>> batch;
+  while (queue_.popBatch(batch, config_.max_batch)) {
+    for (auto& request : batch) answer(uav, *request, soa, route);
+    batch.clear();
+  }
+}
+
+/**
+ * @brief Joins the readers of connections that have closed
+ */
+void Service::reapReaders()
+{
+  for (auto it = readers_.begin(); it != readers_.end();) {
+    if (it->done.load()) {
+      it->thread.join();
+      it = readers_.erase(it);
+    }
+    else {
+      ++it;
+    }
+  }
+}
+
+/**
+ * @brief Serves until a client sends SHUTDOWN; queued requests are drained
+ */
+int Service::run()
+{
+  std::string error;
+  const int listen_fd = listen(error);
+  if (listen_fd < 0) {
+    std::cerr << "Error starting service: " << error << '\n';
+    return EXIT_FAILURE;
+  }
+
+  std::vector<std::thread> workers;
+  for (int w = 0; w < std::max(1, config_.workers); ++w) {
+    DeliveryUAV uav = make_uav_();
+    uav.setResultCache(config_.cache);
+    workers.emplace_back(&Service::workerLoop, this, std::move(uav));
+  }
+  std::cout << "Serving on " << config_.endpoint << " with " << workers.size() << " workers\n" << std::flush;
+
+  while (!stop_.load()) {
+    reapReaders();
+    pollfd entry{ listen_fd, POLLIN, 0 };
+    const int ready = ::poll(&entry, 1, 200);  // re-check stop_ periodically
+    if (ready <= 0) continue;
+    const int client_fd = ::accept(listen_fd, nullptr, nullptr);
+    if (client_fd < 0) continue;
+    auto connection = std::make_shared<Connection>(client_fd);
+    ReaderThread& reader = readers_.emplace_back();
+    reader.connection = connection;
+    reader.thread = std::thread([this, connection, &reader] {
+      readConnection(connection);
+      reader.done.store(true);
+    });
+  }
+  ::close(listen_fd);
+  if (config_.endpoint.compare(0, 5, "unix:") == 0) ::unlink(config_.endpoint.substr(5).c_str());
+
+  // Unblock readers waiting for data; pending answers can still be sent
+  for (auto& reader : readers_) {
+    if (auto connection = reader.connection.lock()) ::shutdown(connection->fd(), SHUT_RD);
+  }
+  for (auto& reader : readers_) reader.thread.join();
+  readers_.clear();
+  queue_.stop();
+  for (auto& worker : workers) worker.join();
+  return EXIT_SUCCESS;
+}
+
+} // namespace
+
+
+/**
+ * @brief Runs the solver as a long-running service
+ *
+ * Listens on a Unix socket or TCP endpoint and accepts waypoint payloads in
+ * the text or binary route format. Every connection has a reader thread that
+ * queues SOLVE frames; `workers` solver threads take up to `max_batch`
+ * requests per wakeup and answer them with their own DeliveryUAV, whose
+ * scratch buffers stay warm between requests. A request still queued when its
+ * deadline expires is answered with EXPIRED without being solved. STATS
+ * reports counters, the queue depth and the p50/p99 latency of the last
+ * 4096 requests.
+ *
+ * @param config   Endpoint, worker count, batch size and default deadline
+ * @param make_uav Builds the configured UAV of each worker
+ * @return int EXIT_SUCCESS after a SHUTDOWN request, EXIT_FAILURE if the
+ *         endpoint cannot be opened
+ */
+int runSolverService(const ServiceConfig& config, const UavFactory& make_uav)
+{
+  Service service(config, make_uav);
+  return service.run();
+}
+
+#else
+
+int runSolverService(const ServiceConfig& config, const UavFactory&)
+{
+  std::cerr << "Error starting service: " << config.endpoint << ": sockets are not supported on this platform\n";
+  return EXIT_FAILURE;
+}
+
+#endif
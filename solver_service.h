@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "delivery_uav.h"
+
+/**
+ * ServiceConfig: parameters of the long-running solver service.
+ * - endpoint: "unix:<path>" or "tcp:[host:]port" (host defaults to 127.0.0.1).
+ * - workers: Solver threads; each owns one DeliveryUAV and its warm buffers.
+ * - max_batch: Queued requests a worker takes per wakeup.
+ * - default_deadline_ms: Deadline of requests without their own (0 = none).
+ * - max_payload_bytes: Largest SOLVE payload; longer frames are rejected unread.
+ * - cache: Result cache shared by all workers (nullptr = none).
+ */
+struct ServiceConfig {
+  std::string endpoint;
+  int workers = 1;
+  int max_batch = 8;
+  double default_deadline_ms = 0.0;
+  std::size_t max_payload_bytes = std::size_t(64) << 20;
+  std::shared_ptr<ResultCache> cache;
+};
+
+/**
+ * UavFactory: builds the configured DeliveryUAV of one service worker.
+ */
+using UavFactory = std::function<DeliveryUAV()>;
+
+int runSolverService(const ServiceConfig& config, const UavFactory& make_uav);
@@ -0,0 +1,191 @@
+#include "delivery_uav.h"
+#include "cost_model.h"
+#include "path_utils.h"
+#include "solve_profile.h"
+#include "solve_workspace.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// Blocks per group, the second level of the block bound
+constexpr int kGroupBlocks = 16;
+
+/**
+ * @brief Bounding boxes of the blocks [b * size, (b + 1) * size) of all points
+ */
+void buildBlockBoxes(const WaypointColumns& cols, int block_size, std::vector<BlockBox>& boxes)
+{
+  const int blocks = (cols.count + block_size - 1) / block_size;
+  boxes.resize(blocks);
+  for (int b = 0; b < blocks; ++b) {
+    const int end = std::min(cols.count, (b + 1) * block_size);
+    BlockBox box{ cols.x[b * block_size], cols.x[b * block_size], cols.y[b * block_size], cols.y[b * block_size] };
+    for (int k = b * block_size + 1; k < end; ++k) {
+      box.min_x = std::min(box.min_x, cols.x[k]);
+      box.max_x = std::max(box.max_x, cols.x[k]);
+      box.min_y = std::min(box.min_y, cols.y[k]);
+      box.max_y = std::max(box.max_y, cols.y[k]);
+    }
+    boxes[b] = box;
+  }
+}
+
+/**
+ * @brief Per-axis distance from (x, y) to the box (0 inside it)
+ */
+inline void boxGap(const BlockBox& box, double x, double y, double& dx, double& dy)
+{
+  dx = std::max(0.0, std::max(box.min_x - x, x - box.max_x));
+  dy = std::max(0.0, std::max(box.min_y - y, y - box.max_y));
+}
+
+} // namespace
+
+
+/**
+ * @brief Pruned DP with a spatial lower bound per block of predecessors
+ *
+ * The pruned bound of solvePruned() only uses the skipped penalties, so with
+ * small penalties it hardly stops the scan even though most predecessors lose
+ * on distance alone. Here the points are cut into blocks of block_size_
+ * consecutive indices, each with its bounding box (built once per route) and,
+ * once all its points are final, key[b] = min (dp[j] - prefix[j]) over the
+ * block. Every candidate of block b is then at least
+ *   key[b] + prefix[i-1] + cost.minTravelTime(gap from point i to the box)
+ * and the backward scan skips the whole block when that bound is above the
+ * best candidate so far, without evaluating a single travel time. Groups of
+ * kGroupBlocks blocks carry the same bound one level up, so long runs of
+ * far-away blocks cost one check. Blocks are kept when the bound ties the
+ * best candidate, and skipped blocks only hold worse candidates, so time and
+ * path are those of solvePruned(). The bound is tight for spatially coherent
+ * routes (consecutive waypoints close together), where far-back blocks are
+ * far away.
+ *
+ * Time Complexity: O(N^2 / (B * G)) bound checks worst case, plus the evaluated candidates
+ *
+ * @param cols  Columns of [start, wp1, wp2..., terminal] with penalty prefix sums
+ * @param cost  Cost model policy, as for solve()
+ * @param path  Output vector storing indices of visited (optimal) waypoints in order
+ * @param stats Receives the candidates evaluated and the blocks skipped
+ *              (a skipped group counts as one)
+ * @return double Minimal total time in seconds to complete the course
+ */
+template <typename Cost>
+double DeliveryUAV::solveSpatial(
+  const WaypointColumns& cols,
+  const Cost& cost,
+  std::vector<int>& path,
+  SolveStats& stats) const
+{
+  const int total_points = cols.count - 1;
+  const double* prefix = cols.prefix;
+  const int block_size = block_size_;
+  const int group_size = block_size * kGroupBlocks;
+
+  SolveWorkspace& ws = workspace();
+  AlignedVector<double>& dp = ws.dp;
+  dp.assign(total_points + 1, std::numeric_limits<double>::infinity());
+  dp[0] = 0.0;
+
+  // floor[j] = min over k <= j of (dp[k] - prefix[k]), as in solvePruned()
+  std::vector<double>& floor = ws.floor;
+  floor.assign(total_points + 1, 0.0);
+  floor[0] = dp[0] - prefix[0];
+
+  std::vector<int>& prev_waypoint = ws.prev_waypoint;
+  prev_waypoint.assign(total_points + 1, -1);
+
+  // Level 0: blocks of block_size points, level 1: groups of kGroupBlocks blocks
+  buildBlockBoxes(cols, block_size, ws.block_box);
+  buildBlockBoxes(cols, group_size, ws.group_box);
+  std::vector<double>& block_key = ws.block_key;
+  std::vector<double>& group_key = ws.group_key;
+  block_key.assign(ws.block_box.size(), std::numeric_limits<double>::infinity());
+  group_key.assign(ws.group_box.size(), std::numeric_limits<double>::infinity());
+  block_key[0] = group_key[0] = floor[0];
+
+  // Lower bound of every candidate of a complete block or group
+  auto boxBound = [&](const BlockBox& box, double key, int i) {
+    double dx, dy;
+    boxGap(box, cols.x[i], cols.y[i], dx, dy);
+    return key + prefix[i - 1] + cost.minTravelTime(dx, dy);
+  };
+
+  for (int i = 1; i <= total_points; ++i) {
+    double min_time = std::numeric_limits<double>::max();
+    int bestPrev = -1;
+    const double penalties_before_i = prefix[i - 1];
+    // Blocks and groups below these hold only final points (all j < i)
+    const int complete_blocks = i / block_size;
+    const int complete_groups = i / group_size;
+
+    // Last point of the first complete block below i
+    int block_end = complete_blocks * block_size - 1;
+    for (int j = i - 1; j >= 0; --j) {
+      // Lower bound of every candidate k <= j; the relative slack absorbs
+      // rounding differences between the bounds and the candidate expression
+      const double slack = 1e-12 * std::fabs(min_time);
+      const double bound = floor[j] + penalties_before_i;
+      if (bound - min_time > slack) break;
+
+      // At the last point of a block (or group), try to skip all of it
+      if (j == block_end) {
+        const int block = j / block_size;
+        const int group = block / kGroupBlocks;
+        block_end -= block_size;
+        if (group < complete_groups && (block + 1) % kGroupBlocks == 0 &&
+          boxBound(ws.group_box[group], group_key[group], i) - min_time > slack) {
+          ++stats.blocks_skipped;
+          j = group * group_size;  // --j moves to the last point of the next group
+          block_end = j - 1;
+          continue;
+        }
+        if (boxBound(ws.block_box[block], block_key[block], i) - min_time > slack) {
+          ++stats.blocks_skipped;
+          j = block * block_size;
+          continue;
+        }
+      }
+
+      const double travel = cost.travelTime(cols.x[j], cols.y[j], cols.x[i], cols.y[i], j, i, dp[j]);
+      const double sum_pen = penalties_before_i - prefix[j];
+      const double time_candidate = dp[j] + travel + sum_pen;
+      ++stats.candidates_evaluated;
+
+      // '<=' while scanning downwards keeps the smallest j among equal times
+      if (time_candidate <= min_time) {
+        min_time = time_candidate;
+        bestPrev = j;
+      }
+    }
+
+    dp[i] = min_time + wait_time_;
+    prev_waypoint[i] = bestPrev;
+    const double key = dp[i] - prefix[i];
+    floor[i] = std::min(floor[i - 1], key);
+    block_key[i / block_size] = std::min(block_key[i / block_size], key);
+    group_key[i / group_size] = std::min(group_key[i / group_size], key);
+  }
+
+  {
+    PhaseTimer timer(phaseSink(stats, SolvePhase::Reconstruct, profiling_));
+    reconstructPath(prev_waypoint, total_points, path);
+  }
+  return dp[total_points];
+}
+
+
+/**
+ * @brief SolverMode::Spatial with the UAV's cost model (see solveSpatial())
+ */
+double DeliveryUAV::solveSpatialBlocks(
+  const WaypointColumns& cols,
+  std::vector<int>& path,
+  SolveStats& stats) const
+{
+  return dispatchCostModel(cost_model_.get(), uav_speed_, [&](const auto& cost) {
+    return solveSpatial(cols, cost, path, stats);
+  });
+}
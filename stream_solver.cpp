@@ -0,0 +1,285 @@
+#include "delivery_uav.h"
+#include "bounded_queue.h"
+#include "cost_model.h"
+#include "path_utils.h"
+#include "result_writer.h"
+#include "solve_profile.h"
+#include "waypoint_stream.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <iostream>
+#include <limits>
+#include <thread>
+
+namespace {
+
+struct StreamPoint {
+  double x, y, penalty;
+};
+
+// Points handed from the parser to the solver per block, and blocks in
+// flight: bounds the memory between the two threads to about 768 KiB.
+constexpr std::size_t kStreamBlockPoints = 4096;
+constexpr std::size_t kStreamQueueBlocks = 8;
+
+using BlockQueue = BoundedQueue<std::vector<StreamPoint>>;
+
+/**
+ * FrontierEntry: a solved waypoint that may still be the predecessor of a
+ * later one. floor is the pruning bound min(dp[k] - prefix[k]) over k <= index.
+ */
+struct FrontierEntry {
+  int index;
+  double x, y;
+  double dp;
+  double prefix;
+  double floor;
+};
+
+/**
+ * ParserGuard: stops and joins the parser thread on every exit of the
+ * solver, including an exception in the DP. Cancelling the queue releases
+ * a parser blocked in push().
+ */
+class ParserGuard {
+public:
+  ParserGuard(BlockQueue& queue, std::thread& parser) : queue_(queue), parser_(parser) {}
+  ~ParserGuard() { join(); }
+
+  ParserGuard(const ParserGuard&) = delete;
+  ParserGuard& operator=(const ParserGuard&) = delete;
+
+  void join()
+  {
+    queue_.cancel();
+    if (parser_.joinable()) parser_.join();
+  }
+
+private:
+  BlockQueue& queue_;
+  std::thread& parser_;
+};
+
+} // namespace
+
+
+/**
+ * @brief Solves a text route while it is being parsed
+ *
+ * A parser thread reads the file through a fixed buffer and hands blocks of
+ * waypoints over a bounded queue; the calling thread runs the DP for point i
+ * as soon as it arrives. Instead of full columns, the solver keeps only the
+ * frontier of predecessors that can still be part of an optimal route:
+ * - SolverMode::Window: the last max_skip + 1 points, as solveWindow().
+ * - SolverMode::Pruned: the backward scan of solvePruned(), plus dropping the
+ *   oldest point j once the newest point k dominates it for every later i,
+ *     dp[k] - prefix[k] + dist(j, k) / speed < dp[j] - prefix[j]
+ *   (by the triangle inequality, k is then strictly cheaper than j as the
+ *   predecessor of any i > k, so j can never be selected again).
+ * Both produce the same time and path as their in-memory counterparts. Peak
+ * memory is the frontier plus the queue, and one predecessor link (an int)
+ * per waypoint for the path reconstruction.
+ *
+ * @param input_file_name  Text route (binary routes are rejected)
+ * @param output_file_name Output file, same layout as solveCase()
+ * @param stats            Optional sink for counters, incl. the peak frontier
+ * @return int Status code: 0 for success, 1 for errors
+ */
+int DeliveryUAV::solveStreamCase(
+  const std::string& input_file_name,
+  const std::string& output_file_name,
+  SolveStats* stats) const
+{
+  auto start_time = std::chrono::high_resolution_clock::now();
+  SolveStats case_stats;
+
+  if (solver_mode_ != SolverMode::Window && solver_mode_ != SolverMode::Pruned) {
+    std::cerr << "Streaming requires the window or pruned solver\n";
+    return EXIT_FAILURE;
+  }
+
+  WaypointStreamReader reader;
+  if (!reader.open(input_file_name)) {
+    std::cerr << "Error opening input file: " << input_file_name << '\n';
+    return EXIT_FAILURE;
+  }
+  if (reader.isBinaryRoute()) {
+    std::cerr << "Streaming requires a text route: " << input_file_name << '\n';
+    return EXIT_FAILURE;
+  }
+
+  double start_x, start_y, term_x, term_y;
+  long long count = 0;
+  std::string parse_error;
+  if (!reader.readHeader(start_x, start_y, term_x, term_y, count, parse_error) || count > (1LL << 30)) {
+    if (parse_error.empty()) parse_error = "Number of waypoints (" + std::to_string(count) + ") is too large";
+    std::cerr << "Invalid input format in " << input_file_name << ", " << parse_error << '\n';
+    return EXIT_FAILURE;
+  }
+
+  std::ofstream output_file(output_file_name,
+    output_format_ == OutputFormat::Binary ? std::ios::out | std::ios::binary : std::ios::out);
+  if (!output_file.is_open()) {
+    std::cerr << "Error opening output file: " << output_file_name << '\n';
+    return EXIT_FAILURE;
+  }
+
+  // ----------------------
+  // Parser thread
+  // ----------------------
+  BlockQueue queue(kStreamQueueBlocks);
+  const EuclideanCost cost(uav_speed_);
+  bool parse_failed = false;  // read by the solver only after join()
+  long long parse_us = 0;
+  std::thread parser([&] {
+    PhaseTimer timer(profiling_ ? &parse_us : nullptr);
+    std::vector<StreamPoint> block;
+    block.reserve(kStreamBlockPoints);
+    for (long long i = 1; i <= count && !parse_failed; ++i) {
+      StreamPoint p;
+      if (!reader.readWaypoint(i, count, p.x, p.y, p.penalty, parse_error)) {
+        parse_failed = true;
+        break;
+      }
+      block.push_back(p);
+      if (block.size() == kStreamBlockPoints) {
+        if (!queue.push(std::move(block))) return;
+        block = std::vector<StreamPoint>();
+        block.reserve(kStreamBlockPoints);
+      }
+    }
+    if (!parse_failed && !reader.readEnd(count, parse_error)) parse_failed = true;
+    if (!block.empty()) queue.push(std::move(block));
+    queue.close();
+  });
+  ParserGuard parser_guard(queue, parser);
+
+  // ----------------------
+  // Core Algorithm Execution
+  // ----------------------
+  PhaseTimer dp_timer(phaseSink(case_stats, SolvePhase::Dp, profiling_));
+  const bool windowed = solver_mode_ == SolverMode::Window;
+  const std::size_t window = (std::size_t)std::min<long long>(max_skip_, count) + 1;
+
+  std::deque<FrontierEntry> frontier;
+  frontier.push_back({ 0, start_x, start_y, 0.0, 0.0, 0.0 });
+  // The header count is not trusted for memory: the links grow with the
+  // waypoints actually read
+  std::vector<int> prev_waypoint;
+  prev_waypoint.reserve(std::min<std::size_t>((std::size_t)count + 2, kStreamBlockPoints * kStreamQueueBlocks));
+  prev_waypoint.push_back(-1);
+  double running = 0.0;  // prefix sum of the penalties read so far
+  double last = 0.0;
+
+  // Relaxes point i at (x, y) against the frontier and appends it
+  auto advance = [&](int i, double x, double y, double penalty) {
+    const double penalties_before_i = running;
+    double min_time = std::numeric_limits<double>::max();
+    int bestPrev = -1;
+
+    if (windowed) {
+      while (frontier.size() > window) frontier.pop_front();
+      for (const FrontierEntry& e : frontier) {
+        const double travel = cost.travelTime(e.x, e.y, x, y, e.index, i, e.dp);
+        const double time_candidate = e.dp + travel + (penalties_before_i - e.prefix);
+        if (time_candidate < min_time) {
+          min_time = time_candidate;
+          bestPrev = e.index;
+        }
+      }
+      case_stats.candidates_evaluated += (long long)frontier.size();
+    }
+    else {
+      for (auto it = frontier.rbegin(); it != frontier.rend(); ++it) {
+        const double bound = it->floor + penalties_before_i;
+        if (bound - min_time > 1e-12 * std::fabs(min_time)) break;
+
+        const double travel = cost.travelTime(it->x, it->y, x, y, it->index, i, it->dp);
+        const double time_candidate = it->dp + travel + (penalties_before_i - it->prefix);
+        ++case_stats.candidates_evaluated;
+        if (time_candidate <= min_time) {
+          min_time = time_candidate;
+          bestPrev = it->index;
+        }
+      }
+    }
+
+    running += penalty;
+    last = min_time + wait_time_;
+    prev_waypoint.push_back(bestPrev);
+    const FrontierEntry entry{ i, x, y, last, running, std::min(frontier.back().floor, last - running) };
+
+    if (!windowed) {
+      // Drop old predecessors the new point beats for every later waypoint; the
+      // slack keeps rounding in the candidate expression from breaking ties
+      const double key = entry.dp - entry.prefix;
+      while (!frontier.empty()) {
+        const FrontierEntry& old = frontier.front();
+        const double via_new = key + cost.travelTime(x, y, old.x, old.y, i, old.index, entry.dp);
+        const double slack = 1e-9 * (std::fabs(old.dp) + std::fabs(old.prefix));
+        if (!(via_new < old.dp - old.prefix - slack)) break;
+        frontier.pop_front();
+      }
+    }
+    frontier.push_back(entry);
+    case_stats.peak_frontier = std::max<long long>(case_stats.peak_frontier, (long long)frontier.size());
+  };
+
+  std::vector<StreamPoint> block;
+  int i = 0;
+  while (queue.pop(block)) {
+    for (const StreamPoint& p : block) advance(++i, p.x, p.y, p.penalty);
+  }
+  parser_guard.join();
+  if (parse_failed) {
+    std::cerr << "Invalid input format in " << input_file_name << ", " << parse_error << '\n';
+    return EXIT_FAILURE;
+  }
+  advance(i + 1, term_x, term_y, 0.0);  // Terminal point (index N+1), no penalty
+  dp_timer.stop();
+
+  std::vector<int> optimal_path;
+  {
+    PhaseTimer timer(phaseSink(case_stats, SolvePhase::Reconstruct, profiling_));
+    reconstructPath(prev_waypoint, i + 1, optimal_path);
+  }
+  case_stats.phase_us[static_cast<int>(SolvePhase::Load)] = parse_us;  // overlaps Dp
+  case_stats.bytes_read = (long long)reader.bytesRead();
+  reader.close();
+
+  auto end_time = std::chrono::high_resolution_clock::now();
+  auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+
+  // ----------------------
+  // Result Output
+  // ----------------------
+  PhaseTimer output_timer(phaseSink(case_stats, SolvePhase::Output, profiling_));
+  thread_local ResultWriter writer;
+  if (output_format_ == OutputFormat::Binary) {
+    writer.formatBinary(duration.count(), last, optimal_path);
+  }
+  else {
+    writer.formatText(duration.count(), last, optimal_path);
+  }
+  if (!writer.writeTo(output_file)) {
+    std::cerr << "Error writing output file: " << output_file_name << '\n';
+    return EXIT_FAILURE;
+  }
+  output_file.close();
+  output_timer.stop();
+
+  if (profiling_) {
+    case_stats.total_us = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::high_resolution_clock::now() - start_time).count();
+    case_stats.peak_rss_kb = peakResidentKiB();
+    if (stats_sidecar_ && !writeStatsJson(output_file_name + ".stats.json", input_file_name, case_stats)) {
+      std::cerr << "Error writing stats file: " << output_file_name << ".stats.json\n";
+      return EXIT_FAILURE;
+    }
+  }
+  if (stats) *stats = case_stats;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,115 @@
+#include "thread_pool.h"
+
+namespace {
+
+// Number of polls before a waiting thread falls back to sleeping on a
+// condition variable; covers the gap between consecutive DP rows.
+constexpr int kSpinIterations = 4096;
+
+} // namespace
+
+/**
+ * @brief Starts threads - 1 workers; the thread calling parallelFor() is the
+ *        remaining participant.
+ *
+ * @param threads Total number of participating threads (values < 1 are treated as 1)
+ */
+ThreadPool::ThreadPool(int threads)
+{
+  const int workers = (threads > 1) ? threads - 1 : 0;
+  workers_.reserve(workers);
+  for (int t = 0; t < workers; ++t) {
+    workers_.emplace_back(&ThreadPool::workerLoop, this);
+  }
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_.store(true, std::memory_order_release);
+  }
+  wake_.notify_all();
+  for (auto& worker : workers_) worker.join();
+}
+
+int ThreadPool::concurrency() const
+{
+  return (int)workers_.size() + 1;
+}
+
+/**
+ * @brief Runs task(0) .. task(tasks - 1) across the pool and waits for completion
+ *
+ * Tasks are claimed dynamically from a shared counter. Every worker reports
+ * back once per call, which doubles as the barrier that stops a late worker
+ * from claiming tasks belonging to the next call.
+ *
+ * @param tasks Number of tasks
+ * @param task  Callable invoked with the task index; must not throw
+ */
+void ThreadPool::parallelFor(int tasks, const std::function<void(int)>& task)
+{
+  if (tasks <= 0) return;
+  if (workers_.empty() || tasks == 1) {
+    for (int t = 0; t < tasks; ++t) task(t);
+    return;
+  }
+
+  std::lock_guard<std::mutex> submit_lock(submit_mutex_);
+  task_ = &task;
+  task_count_ = tasks;
+  next_task_.store(0, std::memory_order_relaxed);
+  arrived_.store(0, std::memory_order_relaxed);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    generation_.fetch_add(1, std::memory_order_release);
+  }
+  wake_.notify_all();
+
+  runTasks();
+
+  const int workers = (int)workers_.size();
+  for (int spin = 0; spin < kSpinIterations; ++spin) {
+    if (arrived_.load(std::memory_order_acquire) == workers) return;
+    std::this_thread::yield();
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_.wait(lock, [&] { return arrived_.load(std::memory_order_acquire) == workers; });
+}
+
+void ThreadPool::runTasks()
+{
+  for (;;) {
+    const int t = next_task_.fetch_add(1, std::memory_order_relaxed);
+    if (t >= task_count_) break;
+    (*task_)(t);
+  }
+}
+
+void ThreadPool::workerLoop()
+{
+  std::uint64_t seen = 0;
+  for (;;) {
+    bool ready = false;
+    for (int spin = 0; spin < kSpinIterations && !ready; ++spin) {
+      ready = generation_.load(std::memory_order_acquire) != seen || stop_.load(std::memory_order_acquire);
+      if (!ready) std::this_thread::yield();
+    }
+    if (!ready) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      wake_.wait(lock, [&] {
+        return generation_.load(std::memory_order_acquire) != seen || stop_.load(std::memory_order_acquire);
+      });
+    }
+    if (stop_.load(std::memory_order_acquire)) return;
+
+    seen = generation_.load(std::memory_order_acquire);
+    runTasks();
+
+    if (arrived_.fetch_add(1, std::memory_order_acq_rel) + 1 == (int)workers_.size()) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      done_.notify_one();
+    }
+  }
+}
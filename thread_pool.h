@@ -0,0 +1,47 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "parallel_executor.h"
+
+/**
+ * ThreadPool: persistent fork-join pool for short, frequent parallel loops.
+ *
+ * Workers stay alive between calls and spin briefly before sleeping, so the
+ * per-call latency stays small enough to dispatch one loop per DP row.
+ * Concurrent parallelFor() calls from different threads are serialized.
+ */
+class ThreadPool : public ParallelExecutor {
+public:
+  explicit ThreadPool(int threads);
+  ~ThreadPool() override;
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  int concurrency() const override;
+  void parallelFor(int tasks, const std::function<void(int)>& task) override;
+
+private:
+  void workerLoop();
+  void runTasks();
+
+  std::vector<std::thread> workers_;
+
+  std::mutex submit_mutex_;       // serializes parallelFor() callers
+  std::mutex mutex_;              // guards sleeping/waking
+  std::condition_variable wake_;  // new generation or stop
+  std::condition_variable done_;  // all workers finished the generation
+
+  const std::function<void(int)>* task_ = nullptr;
+  int task_count_ = 0;
+  std::atomic<int> next_task_{ 0 };
+  std::atomic<int> arrived_{ 0 };
+  std::atomic<std::uint64_t> generation_{ 0 };
+  std::atomic<bool> stop_{ false };
+};
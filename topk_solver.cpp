@@ -0,0 +1,174 @@
+#include "delivery_uav.h"
+#include "cost_model.h"
+#include "solve_profile.h"
+#include "solve_workspace.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+/**
+ * @brief Label order of the top-K solver: lower time first, then the smaller
+ *        predecessor and predecessor rank (the smallest-j tie-break of solve())
+ */
+inline bool labelBefore(const RouteLabel& a, const RouteLabel& b)
+{
+  if (a.time != b.time) return a.time < b.time;
+  if (a.prev != b.prev) return a.prev < b.prev;
+  return a.prev_rank < b.prev_rank;
+}
+
+} // namespace
+
+
+/**
+ * @brief K best routes in one DP pass
+ *
+ * Instead of one bestPrev, every point i keeps its K best labels
+ * (time, predecessor j, rank of the label of j that is extended), in a
+ * bounded max-heap stored in place. Since the labels of j are sorted and
+ * every cost model is FIFO (departing later never arrives earlier), the
+ * candidates from j are non-decreasing in the rank, so the inner loop stops
+ * at the first rank that does not enter the full heap: only j's best label
+ * is evaluated for most predecessors. The scan over j is the backward scan
+ * of solvePruned() with the heap's worst label as the threshold, so the cost
+ * stays close to one pruned solve. Each label extends a distinct label of
+ * its predecessor, so the K labels of the terminal are K distinct routes;
+ * they are rebuilt by walking the (point, rank) links back to the start.
+ *
+ * @param cols   Columns of [start, wp1, wp2..., terminal] with penalty prefix sums
+ * @param cost   Cost model policy, as for solve()
+ * @param k      Number of routes to keep (>= 1)
+ * @param routes Receives up to k routes, best first
+ * @param stats  Receives the number of candidate labels evaluated
+ */
+template <typename Cost>
+void DeliveryUAV::solveTopK(
+  const WaypointColumns& cols,
+  const Cost& cost,
+  int k,
+  std::vector<RouteAlternative>& routes,
+  SolveStats& stats) const
+{
+  const int total_points = cols.count - 1;
+  const double* prefix = cols.prefix;
+  SolveWorkspace& ws = workspace();
+  std::vector<RouteLabel>& labels = ws.labels;
+  std::vector<int>& label_count = ws.label_count;
+  labels.resize((std::size_t)(total_points + 1) * k);
+  label_count.assign(total_points + 1, 0);
+  labels[0] = RouteLabel{ 0.0, -1, -1 };
+  label_count[0] = 1;
+
+  // floor[j] = min over points <= j of (best time - prefix), as in solvePruned()
+  std::vector<double>& floor = ws.floor;
+  floor.assign(total_points + 1, 0.0);
+  floor[0] = -prefix[0];
+
+  for (int i = 1; i <= total_points; ++i) {
+    RouteLabel* heap = &labels[(std::size_t)i * k];
+    int size = 0;
+    const double penalties_before_i = prefix[i - 1];
+
+    for (int j = i - 1; j >= 0; --j) {
+      if (size == k) {
+        const double worst = heap[0].time;
+        if (floor[j] + penalties_before_i - worst > 1e-12 * std::fabs(worst)) break;
+      }
+      const RouteLabel* from = &labels[(std::size_t)j * k];
+      const double sum_pen = penalties_before_i - prefix[j];
+      for (int r = 0; r < label_count[j]; ++r) {
+        const double depart = from[r].time;
+        const double travel = cost.travelTime(cols.x[j], cols.y[j], cols.x[i], cols.y[i], j, i, depart);
+        const RouteLabel candidate{ depart + travel + sum_pen, j, r };
+        ++stats.candidates_evaluated;
+        if (size < k) {
+          heap[size++] = candidate;
+          std::push_heap(heap, heap + size, labelBefore);
+        }
+        else if (labelBefore(candidate, heap[0])) {
+          std::pop_heap(heap, heap + size, labelBefore);
+          heap[size - 1] = candidate;
+          std::push_heap(heap, heap + size, labelBefore);
+        }
+        else {
+          break;  // later ranks of j are no better
+        }
+      }
+    }
+
+    std::sort_heap(heap, heap + size, labelBefore);
+    for (int r = 0; r < size; ++r) heap[r].time += wait_time_;
+    label_count[i] = size;
+    floor[i] = std::min(floor[i - 1], heap[0].time - prefix[i]);
+  }
+
+  PhaseTimer timer(phaseSink(stats, SolvePhase::Reconstruct, profiling_));
+  const int found = label_count[total_points];
+  routes.resize(found);
+  for (int r = 0; r < found; ++r) {
+    const RouteLabel& last = labels[(std::size_t)total_points * k + r];
+    routes[r].total_time = last.time;
+
+    // Count the points, then fill the path back to front (see reconstructPath)
+    std::size_t length = 1;
+    for (int point = total_points, rank = r; point != 0;) {
+      const RouteLabel& label = labels[(std::size_t)point * k + rank];
+      point = label.prev;
+      rank = label.prev_rank;
+      ++length;
+    }
+    std::vector<int>& path = routes[r].path;
+    path.resize(length);
+    std::size_t pos = length;
+    for (int point = total_points, rank = r; point != 0;) {
+      path[--pos] = point;
+      const RouteLabel& label = labels[(std::size_t)point * k + rank];
+      point = label.prev;
+      rank = label.prev_rank;
+    }
+    path[0] = 0;
+  }
+}
+
+
+/**
+ * @brief Solves a route for its K best distinct routes
+ *
+ * Runs the top-K DP of solveTopK() with the UAV's cost model. The first
+ * route is the optimal route of solve() (same time and tie-break); fewer
+ * than k routes are returned if the route has fewer distinct ways. A route
+ * with N waypoints has at most 2^N of them (each waypoint visited or
+ * skipped), so k is clamped to that before the labels are allocated.
+ *
+ * @param cols   Columns of [start, wp1, wp2..., terminal] with penalty prefix sums
+ * @param k      Number of routes (1..kMaxTopRoutes)
+ * @param routes Receives the routes, best first; reused buffers keep their capacity
+ * @param stats  Optional sink for solver counters
+ * @throws std::invalid_argument if k is outside 1..kMaxTopRoutes
+ */
+void DeliveryUAV::solveTopRoutes(
+  const WaypointColumns& cols,
+  int k,
+  std::vector<RouteAlternative>& routes,
+  SolveStats* stats) const
+{
+  if (k < 1 || k > kMaxTopRoutes) {
+    throw std::invalid_argument("solveTopRoutes: k must be in 1.." + std::to_string(kMaxTopRoutes) + ", got " +
+      std::to_string(k));
+  }
+  const int waypoints = cols.count - 2;
+  if (waypoints < 30) k = std::min(k, 1 << waypoints);
+
+  SolveStats route_stats;
+  PhaseTimer solve_timer(phaseSink(route_stats, SolvePhase::Dp, profiling_));
+  dispatchCostModel(cost_model_.get(), uav_speed_, [&](const auto& cost) {
+    solveTopK(cols, cost, k, routes, route_stats);
+  });
+  solve_timer.stop();
+  route_stats.phase_us[static_cast<int>(SolvePhase::Dp)] -=
+    route_stats.phase_us[static_cast<int>(SolvePhase::Reconstruct)];
+  if (stats) *stats = route_stats;
+}
@@ -0,0 +1,260 @@
+#include "waypoint_loader.h"
+#include "mapped_file.h"
+#include <charconv>
+
+namespace {
+
+/**
+ * TextCursor: position within a text buffer plus the current line number,
+ * used to report where malformed input was found.
+ */
+struct TextCursor {
+  const char* pos;
+  const char* end;
+  int line = 1;
+
+  void skipSpace() {
+    while (pos < end && (*pos == ' ' || *pos == '\t' || *pos == '\r' || *pos == '\n')) {
+      if (*pos == '\n') ++line;
+      ++pos;
+    }
+  }
+
+  bool atEnd() {
+    skipSpace();
+    return pos >= end;
+  }
+
+  template <typename T>
+  bool parseNumber(T& value) {
+    skipSpace();
+    const char* first = pos;
+    if (first < end && *first == '+') ++first;  // from_chars rejects a leading '+'
+    const auto [ptr, ec] = std::from_chars(first, end, value);
+    if (ec != std::errc() || ptr == first) return false;
+    if (ptr < end && !(*ptr == ' ' || *ptr == '\t' || *ptr == '\r' || *ptr == '\n')) return false;
+    pos = ptr;
+    return true;
+  }
+};
+
+std::string lineMessage(const TextCursor& cursor, const std::string& what)
+{
+  return "line " + std::to_string(cursor.line) + ": " + what;
+}
+
+/**
+ * @brief Parses one case (start, terminal, N, N waypoints) at the cursor
+ */
+bool parseCase(TextCursor& cursor, WaypointSoA& soa, std::string& error)
+{
+  double start_x, start_y, term_x, term_y;
+  if (!cursor.parseNumber(start_x) || !cursor.parseNumber(start_y)) {
+    error = lineMessage(cursor, "expected start point coordinates");
+    return false;
+  }
+  if (!cursor.parseNumber(term_x) || !cursor.parseNumber(term_y)) {
+    error = lineMessage(cursor, "expected terminal point coordinates");
+    return false;
+  }
+
+  long long n = 0;
+  if (!cursor.parseNumber(n)) {
+    error = lineMessage(cursor, "expected number of waypoints");
+    return false;
+  }
+  if (n < 0) {
+    error = lineMessage(cursor, "Number of waypoints (" + std::to_string(n) + ") must be non-negative");
+    return false;
+  }
+  if (n > (1LL << 30)) {
+    error = lineMessage(cursor, "Number of waypoints (" + std::to_string(n) + ") is too large");
+    return false;
+  }
+  // Every waypoint takes at least 6 bytes ("x y p" and a separator), so a
+  // truncated file is rejected before the columns are sized for it
+  const long long room = ((long long)(cursor.end - cursor.pos) + 1) / 6;
+  if (n > room) {
+    error = lineMessage(cursor, "expected " + std::to_string(n) + " waypoints, the remaining input holds at most " +
+      std::to_string(room));
+    return false;
+  }
+
+  const size_t count = (size_t)n + 2;
+  soa.x.resize(count);
+  soa.y.resize(count);
+  soa.penalty.resize(count);
+  soa.prefix.resize(count);
+
+  soa.x[0] = start_x;  // Start point (index 0)
+  soa.y[0] = start_y;
+  soa.penalty[0] = 0.0;
+  soa.prefix[0] = 0.0;
+
+  double running = 0.0;
+  for (size_t i = 1; i <= (size_t)n; ++i) {
+    if (cursor.atEnd()) {
+      error = lineMessage(cursor, "expected " + std::to_string(n) + " waypoints, found " + std::to_string(i - 1));
+      return false;
+    }
+    if (!cursor.parseNumber(soa.x[i]) || !cursor.parseNumber(soa.y[i]) || !cursor.parseNumber(soa.penalty[i])) {
+      error = lineMessage(cursor, "malformed waypoint " + std::to_string(i) + " (expected x y penalty)");
+      return false;
+    }
+    running += soa.penalty[i];
+    soa.prefix[i] = running;
+  }
+
+  soa.x[n + 1] = term_x;  // Terminal point (index N+1)
+  soa.y[n + 1] = term_y;
+  soa.penalty[n + 1] = 0.0;
+  soa.prefix[n + 1] = running;  // Terminal inherits previous sum (no penalty)
+
+  return true;
+}
+
+/**
+ * @brief True if the cursor is at a lone 0 that ends the input
+ */
+bool atEndMarker(TextCursor& cursor)
+{
+  TextCursor probe = cursor;
+  long long terminator = -1;
+  if (!probe.parseNumber(terminator) || terminator != 0 || !probe.atEnd()) return false;
+  cursor = probe;
+  return true;
+}
+
+} // namespace
+
+
+/**
+ * @brief Parses a waypoint case from an in-memory text buffer
+ *
+ * Numbers are converted with std::from_chars directly from the buffer into
+ * the SoA columns: no locale handling, no stream state and no intermediate
+ * strings. Input layout (whitespace separated):
+ *   start_x start_y
+ *   term_x term_y
+ *   N
+ *   N lines of: x y penalty
+ * optionally followed by a single 0 end-of-input marker.
+ *
+ * @param begin First byte of the text
+ * @param end   One past the last byte of the text
+ * @param soa   Receives [start, wp1..wpN, terminal] and the penalty prefix sums
+ * @param error Receives a message with the offending line number on failure
+ * @return bool True if the buffer holds exactly one well-formed case
+ */
+bool parseWaypointText(const char* begin, const char* end, WaypointSoA& soa, std::string& error)
+{
+  TextCursor cursor{ begin, end };
+
+  if (!parseCase(cursor, soa, error)) return false;
+
+  // A lone 0 (an empty case) is accepted as end-of-input marker
+  cursor.skipSpace();
+  const TextCursor after_waypoints = cursor;
+  if (!cursor.atEnd() && !atEndMarker(cursor)) {
+    error = lineMessage(after_waypoints, "unexpected data after " + std::to_string(soa.x.size() - 2) + " waypoints");
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Loads a waypoint case from a file through a memory mapping
+ *
+ * @param path  Input file (see parseWaypointText() for the layout)
+ * @param soa   Receives the case
+ * @param error Receives a message on failure
+ * @return bool True on success
+ */
+bool loadWaypointFile(const std::string& path, WaypointSoA& soa, std::string& error)
+{
+  MappedFile file;
+  if (!file.open(path)) {
+    error = "cannot open file";
+    return false;
+  }
+  return parseWaypointText(file.data(), file.data() + file.size(), soa, error);
+}
+
+
+/**
+ * @brief Starts reading a multi-case text buffer
+ *
+ * The buffer holds any number of cases in the layout of parseWaypointText(),
+ * one after the other:
+ *   [K]        optional header: a first line with the single integer K
+ *   case 1     start_x start_y / term_x term_y / N / N lines of x y penalty
+ *   case 2
+ *   ...
+ *   [0]        optional end-of-input marker
+ * A case always starts with a line of two coordinates, so a first line with
+ * one number is the header. With a header, exactly K cases must follow.
+ *
+ * @param begin First byte of the text
+ * @param end   One past the last byte of the text
+ * @param error Receives a message with the offending line number on failure
+ * @return bool False for a malformed header
+ */
+bool WaypointCaseReader::reset(const char* begin, const char* end, std::string& error)
+{
+  TextCursor cursor{ begin, end };
+  declared_ = -1;
+  read_ = 0;
+  cursor.skipSpace();
+
+  int tokens = 0;
+  for (const char* p = cursor.pos; p < end && *p != '\n'; ++p) {
+    const bool space = *p == ' ' || *p == '\t' || *p == '\r';
+    if (!space && (p == cursor.pos || p[-1] == ' ' || p[-1] == '\t' || p[-1] == '\r')) ++tokens;
+  }
+  if (tokens == 1 && !atEndMarker(cursor)) {
+    if (!cursor.parseNumber(declared_) || declared_ < 0) {
+      error = lineMessage(cursor, "expected number of cases");
+      return false;
+    }
+  }
+  pos_ = cursor.pos;
+  end_ = end;
+  line_ = cursor.line;
+  return true;
+}
+
+/**
+ * @brief Parses the next case
+ *
+ * @param soa   Receives [start, wp1..wpN, terminal] and the penalty prefix sums
+ * @param done  Set to true, with soa untouched, once every case has been read
+ * @param error Receives a message with the offending line number on failure
+ * @return bool False on malformed input (or a case count other than the header's)
+ */
+bool WaypointCaseReader::next(WaypointSoA& soa, bool& done, std::string& error)
+{
+  TextCursor cursor{ pos_, end_, line_ };
+  done = false;
+  const bool all_declared = declared_ >= 0 && read_ == declared_;
+  if (cursor.atEnd() || atEndMarker(cursor)) {
+    if (declared_ >= 0 && !all_declared) {
+      error = lineMessage(cursor, "expected " + std::to_string(declared_) + " cases, found " + std::to_string(read_));
+      return false;
+    }
+    done = true;
+  }
+  else if (all_declared) {
+    error = lineMessage(cursor, "unexpected data after " + std::to_string(declared_) + " cases");
+    return false;
+  }
+  else {
+    if (!parseCase(cursor, soa, error)) {
+      error = "case " + std::to_string(read_ + 1) + ", " + error;
+      return false;
+    }
+    ++read_;
+  }
+  pos_ = cursor.pos;
+  line_ = cursor.line;
+  return true;
+}
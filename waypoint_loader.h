@@ -0,0 +1,29 @@
+#pragma once
+
+#include <string>
+
+#include "waypoint_soa.h"
+
+bool parseWaypointText(const char* begin, const char* end, WaypointSoA& soa, std::string& error);
+bool loadWaypointFile(const std::string& path, WaypointSoA& soa, std::string& error);
+
+/**
+ * WaypointCaseReader: parses the cases of a multi-case text buffer one at a
+ * time, straight into SoA columns like parseWaypointText(). Call reset(),
+ * then next() until it reports done. The buffer must outlive the reader.
+ */
+class WaypointCaseReader {
+public:
+  bool reset(const char* begin, const char* end, std::string& error);
+  bool next(WaypointSoA& soa, bool& done, std::string& error);
+
+  long long declaredCases() const { return declared_; }  // -1 without a header
+  long long casesRead() const { return read_; }
+
+private:
+  const char* pos_ = nullptr;
+  const char* end_ = nullptr;
+  int line_ = 1;
+  long long declared_ = -1;
+  long long read_ = 0;
+};
@@ -0,0 +1,41 @@
+#include "waypoint_soa.h"
+
+/**
+ * @brief Builds the column layout from the interleaved waypoint vector
+ *
+ * @param waypoints   [start, wp1, wp2..., terminal] as loaded by solveCase
+ * @param prefix_sums Penalty prefix sums aligned with waypoints
+ */
+WaypointSoA::WaypointSoA(const std::vector<WayPoint>& waypoints, const std::vector<double>& prefix_sums)
+  : x(waypoints.size()),
+  y(waypoints.size()),
+  penalty(waypoints.size()),
+  prefix(prefix_sums.begin(), prefix_sums.end())
+{
+  for (size_t i = 0; i < waypoints.size(); ++i) {
+    x[i] = waypoints[i].x;
+    y[i] = waypoints[i].y;
+    penalty[i] = waypoints[i].penalty;
+  }
+}
+
+/**
+ * @brief Rebuilds the interleaved layout used by the reference solver
+ */
+std::vector<WayPoint> toWayPoints(const WaypointColumns& cols)
+{
+  std::vector<WayPoint> waypoints;
+  toWayPoints(cols, waypoints);
+  return waypoints;
+}
+
+/**
+ * @brief Same as toWayPoints(cols), into a reused vector
+ */
+void toWayPoints(const WaypointColumns& cols, std::vector<WayPoint>& waypoints)
+{
+  waypoints.resize(cols.count);
+  for (int i = 0; i < cols.count; ++i) {
+    waypoints[i] = WayPoint(cols.x[i], cols.y[i], cols.penalty[i]);
+  }
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+#include "delivery_uav.h"
+
+/**
+ * AlignedAllocator: std::allocator replacement returning storage aligned to
+ * Alignment bytes (64 = one cache line / one AVX-512 register).
+ */
+template <typename T, std::size_t Alignment = 64>
+struct AlignedAllocator {
+  using value_type = T;
+
+  template <typename U>
+  struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+  AlignedAllocator() noexcept = default;
+  template <typename U>
+  AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+  T* allocate(std::size_t n) {
+    return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+  }
+  void deallocate(T* p, std::size_t) noexcept {
+    ::operator delete(p, std::align_val_t(Alignment));
+  }
+
+  template <typename U>
+  bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+  template <typename U>
+  bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept { return false; }
+};
+
+template <typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+/**
+ * WaypointColumns: non-owning view of the columns read by the DP kernels.
+ * Index 0 is the start point and index count - 1 the terminal point; prefix
+ * follows the convention of DeliveryUAV::solve.
+ */
+struct WaypointColumns {
+  const double* x = nullptr;
+  const double* y = nullptr;
+  const double* penalty = nullptr;
+  const double* prefix = nullptr;
+  int count = 0;
+};
+
+std::vector<WayPoint> toWayPoints(const WaypointColumns& cols);
+void toWayPoints(const WaypointColumns& cols, std::vector<WayPoint>& waypoints);
+
+/**
+ * WaypointSoA: structure-of-arrays copy of [start, wp1..wpN, terminal] with
+ * every column stored contiguously and 64-byte aligned.
+ */
+struct WaypointSoA {
+  AlignedVector<double> x;
+  AlignedVector<double> y;
+  AlignedVector<double> penalty;
+  AlignedVector<double> prefix;
+
+  WaypointSoA() = default;
+  WaypointSoA(const std::vector<WayPoint>& waypoints, const std::vector<double>& prefix_sums);
+
+  int size() const { return (int)x.size(); }
+  WaypointColumns columns() const { return { x.data(), y.data(), penalty.data(), prefix.data(), size() }; }
+};
@@ -0,0 +1,178 @@
+#include "waypoint_stream.h"
+#include "binary_route.h"
+#include <charconv>
+#include <cstring>
+
+namespace {
+
+inline bool isSpace(char c)
+{
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+} // namespace
+
+
+WaypointStreamReader::~WaypointStreamReader()
+{
+  close();
+}
+
+bool WaypointStreamReader::open(const std::string& path, std::size_t buffer_size)
+{
+  close();
+  file_ = std::fopen(path.c_str(), "rb");
+  if (!file_) return false;
+  buffer_.resize(buffer_size > 64 ? buffer_size : 64);
+  return true;
+}
+
+void WaypointStreamReader::close()
+{
+  if (file_) std::fclose(file_);
+  file_ = nullptr;
+  pos_ = end_ = 0;
+  eof_ = false;
+  line_ = 1;
+  bytes_read_ = 0;
+}
+
+/**
+ * @brief Keeps the bytes [keep_from, end_) at the front of the buffer and
+ *        appends as much of the file as fits behind them
+ * @return bool False once the file is exhausted
+ */
+bool WaypointStreamReader::fill(std::size_t keep_from)
+{
+  std::memmove(buffer_.data(), buffer_.data() + keep_from, end_ - keep_from);
+  end_ -= keep_from;
+  pos_ -= keep_from;
+  if (end_ == buffer_.size()) buffer_.resize(buffer_.size() * 2);  // token longer than the buffer
+
+  const std::size_t got = std::fread(buffer_.data() + end_, 1, buffer_.size() - end_, file_);
+  end_ += got;
+  bytes_read_ += got;
+  if (got == 0) eof_ = true;
+  return got > 0;
+}
+
+/**
+ * @brief Skips whitespace, refilling the buffer as needed
+ * @return bool True if the file holds no further token
+ */
+bool WaypointStreamReader::atEnd()
+{
+  for (;;) {
+    while (pos_ < end_ && isSpace(buffer_[pos_])) {
+      if (buffer_[pos_] == '\n') ++line_;
+      ++pos_;
+    }
+    if (pos_ < end_) return false;
+    if (eof_ || !fill(pos_)) return true;
+  }
+}
+
+/**
+ * @brief Returns the next whitespace-separated token; a token cut by the end
+ *        of the buffer is completed from the file first
+ */
+bool WaypointStreamReader::nextToken(const char*& first, const char*& last)
+{
+  if (atEnd()) return false;
+
+  std::size_t start = pos_;
+  for (;;) {
+    while (pos_ < end_ && !isSpace(buffer_[pos_])) ++pos_;
+    if (pos_ < end_ || eof_) break;
+    fill(start);
+    start = 0;
+  }
+  first = buffer_.data() + start;
+  last = buffer_.data() + pos_;
+  return true;
+}
+
+template <typename T>
+bool WaypointStreamReader::parseNumber(T& value)
+{
+  const char* first;
+  const char* last;
+  if (!nextToken(first, last)) return false;
+  if (*first == '+') ++first;  // from_chars rejects a leading '+'
+  const auto [ptr, ec] = std::from_chars(first, last, value);
+  return ec == std::errc() && ptr == last && ptr != first;
+}
+
+std::string WaypointStreamReader::lineMessage(const std::string& what) const
+{
+  return "line " + std::to_string(line_) + ": " + what;
+}
+
+/**
+ * @brief Returns true if the file starts with the binary route magic; must
+ *        be called before any other read
+ */
+bool WaypointStreamReader::isBinaryRoute()
+{
+  if (end_ - pos_ < sizeof(kBinaryRouteMagic) && !eof_) fill(pos_);
+  return ::isBinaryRoute(buffer_.data() + pos_, end_ - pos_);
+}
+
+/**
+ * @brief Reads the start point, the terminal point and the waypoint count
+ */
+bool WaypointStreamReader::readHeader(double& start_x, double& start_y, double& term_x, double& term_y,
+  long long& count, std::string& error)
+{
+  if (!parseNumber(start_x) || !parseNumber(start_y)) {
+    error = lineMessage("expected start point coordinates");
+    return false;
+  }
+  if (!parseNumber(term_x) || !parseNumber(term_y)) {
+    error = lineMessage("expected terminal point coordinates");
+    return false;
+  }
+  if (!parseNumber(count)) {
+    error = lineMessage("expected number of waypoints");
+    return false;
+  }
+  if (count < 0) {
+    error = lineMessage("Number of waypoints (" + std::to_string(count) + ") must be non-negative");
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Reads waypoint `index` (1-based) of `count`
+ */
+bool WaypointStreamReader::readWaypoint(long long index, long long count, double& x, double& y,
+  double& penalty, std::string& error)
+{
+  if (atEnd()) {
+    error = lineMessage("expected " + std::to_string(count) + " waypoints, found " + std::to_string(index - 1));
+    return false;
+  }
+  if (!parseNumber(x) || !parseNumber(y) || !parseNumber(penalty)) {
+    error = lineMessage("malformed waypoint " + std::to_string(index) + " (expected x y penalty)");
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Accepts the end of the file, optionally after a lone 0 end marker
+ */
+bool WaypointStreamReader::readEnd(long long count, std::string& error)
+{
+  if (atEnd()) return true;
+  const int line = line_;
+  const char* first;
+  const char* last;
+  nextToken(first, last);
+  long long terminator = -1;
+  const auto [ptr, ec] = std::from_chars(first, last, terminator);
+  if (ec == std::errc() && ptr == last && terminator == 0 && !nextToken(first, last)) return true;
+  error = "line " + std::to_string(line) + ": unexpected data after " + std::to_string(count) + " waypoints";
+  return false;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * WaypointStreamReader: incremental parser for the text route format.
+ *
+ * Reads the file through a fixed-size buffer (grown only for a single
+ * oversized token), so memory stays constant however many waypoints the
+ * file holds. Numbers are converted with std::from_chars exactly like
+ * parseWaypointText(), and errors carry the same "line L: ..." messages.
+ * Calls must follow the file layout: readHeader(), N x readWaypoint(),
+ * readEnd().
+ */
+class WaypointStreamReader {
+public:
+  WaypointStreamReader() = default;
+  ~WaypointStreamReader();
+
+  WaypointStreamReader(const WaypointStreamReader&) = delete;
+  WaypointStreamReader& operator=(const WaypointStreamReader&) = delete;
+
+  bool open(const std::string& path, std::size_t buffer_size = 1 << 20);
+  void close();
+
+  bool isBinaryRoute();
+  bool readHeader(double& start_x, double& start_y, double& term_x, double& term_y,
+    long long& count, std::string& error);
+  bool readWaypoint(long long index, long long count, double& x, double& y, double& penalty,
+    std::string& error);
+  bool readEnd(long long count, std::string& error);
+
+  std::size_t bytesRead() const { return bytes_read_; }
+
+private:
+  bool fill(std::size_t keep_from);
+  bool atEnd();
+  bool nextToken(const char*& first, const char*& last);
+  template <typename T>
+  bool parseNumber(T& value);
+  std::string lineMessage(const std::string& what) const;
+
+  std::FILE* file_ = nullptr;
+  std::vector<char> buffer_;
+  std::size_t pos_ = 0;
+  std::size_t end_ = 0;
+  bool eof_ = false;
+  int line_ = 1;
+  std::size_t bytes_read_ = 0;
+};
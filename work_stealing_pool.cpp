@@ -0,0 +1,193 @@
+#include "work_stealing_pool.h"
+#include <algorithm>
+
+namespace {
+
+// Polls of the queues before an idle worker goes to sleep.
+constexpr int kSpinIterations = 2048;
+
+// Pool and worker index of the current thread (-1 outside any pool).
+thread_local const void* tls_pool = nullptr;
+thread_local int tls_worker = -1;
+
+/**
+ * ForkGroup: state shared by the tickets of one parallelFor() call. Tickets
+ * keep it alive, so a ticket popped after the call returned is a no-op.
+ */
+struct ForkGroup {
+  const std::function<void(int)>* task = nullptr;
+  int count = 0;
+  std::atomic<int> next{ 0 };
+  std::atomic<int> finished{ 0 };
+
+  void run() {
+    for (;;) {
+      const int t = next.fetch_add(1, std::memory_order_relaxed);
+      if (t >= count) return;
+      (*task)(t);
+      finished.fetch_add(1, std::memory_order_release);
+    }
+  }
+};
+
+} // namespace
+
+/**
+ * @brief Starts the worker threads
+ *
+ * @param threads Number of workers (values < 1 are treated as 1)
+ */
+WorkStealingPool::WorkStealingPool(int threads)
+{
+  const int workers = (threads > 1) ? threads : 1;
+  for (int w = 0; w < workers; ++w) queues_.push_back(std::make_unique<WorkerQueue>());
+  workers_.reserve(workers);
+  for (int w = 0; w < workers; ++w) workers_.emplace_back(&WorkStealingPool::workerLoop, this, w);
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+  waitIdle();
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    stop_.store(true, std::memory_order_release);
+  }
+  wake_.notify_all();
+  for (auto& worker : workers_) worker.join();
+}
+
+int WorkStealingPool::concurrency() const
+{
+  return (int)workers_.size();
+}
+
+/**
+ * @brief Queues a top-level task; waitIdle() returns once all have finished
+ */
+void WorkStealingPool::submit(std::function<void()> task)
+{
+  outstanding_.fetch_add(1, std::memory_order_relaxed);
+  push([this, task = std::move(task)] {
+    task();
+    if (outstanding_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      std::lock_guard<std::mutex> lock(sleep_mutex_);
+      idle_.notify_all();
+    }
+  });
+}
+
+void WorkStealingPool::waitIdle()
+{
+  std::unique_lock<std::mutex> lock(sleep_mutex_);
+  idle_.wait(lock, [&] { return outstanding_.load(std::memory_order_acquire) == 0; });
+}
+
+/**
+ * @brief Runs task(0) .. task(tasks - 1) and returns when all have finished
+ *
+ * Pushes one ticket per additional participant onto the caller's own deque
+ * (or the injection queue when called from outside the pool). Tickets and the
+ * caller claim indices from a shared counter. Once no indices are left the
+ * caller only waits for the indices other workers are still running; it
+ * never picks up unrelated work, so a row of a large case is not held up by
+ * a whole other case.
+ *
+ * @param tasks Number of tasks
+ * @param task  Callable invoked with the task index; must not throw
+ */
+void WorkStealingPool::parallelFor(int tasks, const std::function<void(int)>& task)
+{
+  if (tasks <= 0) return;
+  if (tasks == 1 || workers_.size() == 1) {
+    for (int t = 0; t < tasks; ++t) task(t);
+    return;
+  }
+
+  auto group = std::make_shared<ForkGroup>();
+  group->task = &task;
+  group->count = tasks;
+
+  const int tickets = std::min(tasks, (int)workers_.size()) - 1;
+  for (int t = 0; t < tickets; ++t) {
+    push([group] { group->run(); });
+  }
+
+  group->run();
+  while (group->finished.load(std::memory_order_acquire) < tasks) {
+    std::this_thread::yield();
+  }
+}
+
+void WorkStealingPool::push(Task task)
+{
+  WorkerQueue& queue = (tls_pool == this) ? *queues_[tls_worker] : injection_;
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back(std::move(task));
+  }
+  queued_.fetch_add(1, std::memory_order_release);
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+  }
+  wake_.notify_one();
+}
+
+bool WorkStealingPool::tryPop(int self, Task& task)
+{
+  WorkerQueue& own = *queues_[self];
+  std::lock_guard<std::mutex> lock(own.mutex);
+  if (own.tasks.empty()) return false;
+  task = std::move(own.tasks.back());
+  own.tasks.pop_back();
+  return true;
+}
+
+bool WorkStealingPool::trySteal(int self, Task& task)
+{
+  {
+    std::lock_guard<std::mutex> lock(injection_.mutex);
+    if (!injection_.tasks.empty()) {
+      task = std::move(injection_.tasks.front());
+      injection_.tasks.pop_front();
+      return true;
+    }
+  }
+  const int workers = (int)queues_.size();
+  for (int k = 1; k < workers; ++k) {
+    WorkerQueue& victim = *queues_[(self + k) % workers];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+void WorkStealingPool::workerLoop(int index)
+{
+  tls_pool = this;
+  tls_worker = index;
+
+  int idle_polls = 0;
+  for (;;) {
+    Task task;
+    if (tryPop(index, task) || trySteal(index, task)) {
+      queued_.fetch_sub(1, std::memory_order_acq_rel);
+      task();
+      idle_polls = 0;
+      continue;
+    }
+    if (++idle_polls < kSpinIterations) {
+      std::this_thread::yield();
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    wake_.wait(lock, [&] {
+      return queued_.load(std::memory_order_acquire) > 0 || stop_.load(std::memory_order_acquire);
+    });
+    if (stop_.load(std::memory_order_acquire) && queued_.load(std::memory_order_acquire) == 0) return;
+    idle_polls = 0;
+  }
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "parallel_executor.h"
+
+/**
+ * WorkStealingPool: task pool for batch solving.
+ *
+ * Every worker owns a deque: it pushes and pops its own work at the back and
+ * steals from the front of other workers' deques when it runs dry. Tasks
+ * submitted from outside the pool go through a shared injection queue.
+ * parallelFor() may be called from inside a running task, which lets a
+ * worker solving a large case split its DP rows across idle workers.
+ */
+class WorkStealingPool : public ParallelExecutor {
+public:
+  explicit WorkStealingPool(int threads);
+  ~WorkStealingPool() override;
+
+  WorkStealingPool(const WorkStealingPool&) = delete;
+  WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+  void submit(std::function<void()> task);
+  void waitIdle();
+
+  int concurrency() const override;
+  void parallelFor(int tasks, const std::function<void(int)>& task) override;
+
+private:
+  using Task = std::function<void()>;
+
+  struct alignas(64) WorkerQueue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  void workerLoop(int index);
+  void push(Task task);
+  bool tryPop(int self, Task& task);
+  bool trySteal(int self, Task& task);
+
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  WorkerQueue injection_;
+  std::vector<std::thread> workers_;
+
+  std::atomic<int> queued_{ 0 };       // tasks sitting in any queue
+  std::atomic<int> outstanding_{ 0 };  // submitted top-level tasks not yet finished
+  std::atomic<bool> stop_{ false };
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_;
+  std::condition_variable idle_;
+};